@@ -0,0 +1,47 @@
+#ifndef APP_STATE_H
+#define APP_STATE_H
+
+#include <time.h>
+#include "os_interface.h"
+
+// How many apps we remember at once (the "history" ring)
+#define MAX_TRACKED_APPS 7
+
+// How many processes one app (main process + helpers) may have
+#define MAX_GROUP_MEMBERS 64
+
+// One process belonging to an app group
+typedef struct {
+    int32_t pid;
+    uint64_t start_time;        // Same PID-reuse guard as AppState.start_time
+    int32_t saved_priority;     // Priority before we throttled it (see os_throttle_process)
+    bool applied;               // The app's action was applied to this member
+} GroupMember;
+
+/**
+ * One slot of the tracking history: an application, i.e. a leader PID
+ * (the top of the app's parent chain) plus its helper processes.
+ * This struct lives inside the memory-mapped journal (see journal.h),
+ * so every field write is also a write to the state file.
+ */
+typedef struct {
+    int32_t pid;                // The group leader
+    uint64_t start_time;        // os_get_process_start_time() token, guards against PID reuse
+    char name[MAX_PROC_NAME];
+    GroupMember members[MAX_GROUP_MEMBERS]; // members[0] is always the leader
+    int member_count;
+    time_t members_refreshed;   // Helpers come and go, we re-scan now and then
+    time_t sampled_at;          // When memory/CPU below were measured
+    uint64_t memory_bytes;      // Sum over all members, from the last check
+    uint64_t cpu_time_ns;       // Sum over all members, from the last check
+    double cpu_percent;         // Group CPU usage between the last two checks
+    int rule;                   // Cached policy_resolve() result (see policy.h)
+    time_t last_active_time;
+    time_t frozen_since;        // When the current action was applied
+    int action;                 // PolicyAction we applied, valid while is_frozen
+    int freeze_count;           // The app's "score": how often we put it to sleep
+    bool is_frozen;             // "We did something to it that must be undone"
+    bool valid;
+} AppState;
+
+#endif // APP_STATE_H
@@ -0,0 +1,202 @@
+#include <string.h>
+#include "group.h"
+
+// How far up the parent chain we are willing to climb
+#define MAX_CHAIN_DEPTH 32
+
+// --- PROCESS TABLE SNAPSHOT ---
+// Taken at most once per second and shared by every group in that tick
+static ProcessEntry snapshot[MAX_PROCESSES];
+static int snapshot_count = 0;
+static time_t snapshot_time = 0;
+
+static void ensure_snapshot() {
+    time_t now = time(NULL);
+    if (snapshot_count > 0 && now == snapshot_time) return;
+
+    snapshot_count = os_list_processes(snapshot, MAX_PROCESSES);
+    if (snapshot_count < 0) snapshot_count = 0;
+    snapshot_time = now;
+}
+
+static int32_t parent_of(int32_t pid) {
+    for (int i = 0; i < snapshot_count; i++) {
+        if (snapshot[i].pid == pid) return snapshot[i].parent_pid;
+    }
+    return -1;
+}
+
+// --- APP IDENTITY ---
+// "/Applications/Foo.app/Contents/Frameworks/Foo Helper.app/..." -> "/Applications/Foo.app/"
+// Outside a bundle the full executable path is the identity.
+static bool app_key(int32_t pid, char* key, size_t size) {
+    os_get_process_path(pid, key, size);
+
+    char* bundle = strstr(key, ".app/");
+    if (bundle != NULL) {
+        bundle[5] = '\0';
+        return true;
+    }
+    return false;
+}
+
+static int find_member(const GroupMember* members, int count, int32_t pid) {
+    for (int i = 0; i < count; i++) {
+        if (members[i].pid == pid) return i;
+    }
+    return -1;
+}
+
+static bool skip_process(int32_t pid, bool (*skip)(const char* name, const char* exe_path)) {
+    if (skip == NULL) return false;
+    char name[MAX_PROC_NAME];
+    char path[MAX_PROC_PATH];
+    os_get_process_name(pid, name, MAX_PROC_NAME);
+    os_get_process_path(pid, path, MAX_PROC_PATH);
+    return skip(name, path);
+}
+
+// --- PUBLIC API ---
+
+void group_invalidate_snapshot(void) {
+    snapshot_count = 0;
+}
+
+int32_t group_find_leader(int32_t pid) {
+    char key[MAX_PROC_PATH];
+    app_key(pid, key, sizeof(key));
+    if (key[0] == '\0') return pid; // Can't see its path, treat it as its own app
+
+    ensure_snapshot();
+    int32_t owner = os_get_owner_id(pid);
+    int32_t leader = pid;
+
+    for (int depth = 0; depth < MAX_CHAIN_DEPTH; depth++) {
+        int32_t parent = parent_of(leader);
+        if (parent <= 1) break; // launchd / init / System
+
+        if (os_get_owner_id(parent) != owner) break;
+
+        // Windows keeps stale parent PIDs around: a real parent is older than its child
+        if (os_get_process_start_time(parent) > os_get_process_start_time(leader)) break;
+
+        char parent_key[MAX_PROC_PATH];
+        app_key(parent, parent_key, sizeof(parent_key));
+        if (strcmp(parent_key, key) != 0) break; // Parent is a different app (Finder, a shell...)
+
+        leader = parent;
+    }
+    return leader;
+}
+
+void group_refresh(AppState* app, bool (*skip)(const char* name, const char* exe_path)) {
+    ensure_snapshot();
+
+    GroupMember members[MAX_GROUP_MEMBERS];
+    int count = 0;
+    memset(members, 0, sizeof(members));
+    members[count].pid = app->pid;
+    members[count].start_time = app->start_time;
+    count++;
+
+    char key[MAX_PROC_PATH];
+    bool in_bundle = app_key(app->pid, key, sizeof(key));
+
+    // 1. Descendants that are the same app. Each pass adds one more generation.
+    // Launchers (a shell, an IDE, Steam) start other apps, those are not helpers.
+    bool changed = true;
+    while (changed && count < MAX_GROUP_MEMBERS) {
+        changed = false;
+        for (int i = 0; i < snapshot_count && count < MAX_GROUP_MEMBERS; i++) {
+            int32_t pid = snapshot[i].pid;
+            if (pid <= 1 || find_member(members, count, pid) >= 0) continue;
+
+            int parent = find_member(members, count, snapshot[i].parent_pid);
+            if (parent < 0) continue;
+
+            uint64_t start_time = os_get_process_start_time(pid);
+            if (start_time == 0 || start_time < members[parent].start_time) continue; // Stale parent link
+
+            char child_key[MAX_PROC_PATH];
+            app_key(pid, child_key, sizeof(child_key));
+            if (child_key[0] == '\0' || strcmp(child_key, key) != 0) continue;
+
+            if (skip_process(pid, skip)) continue;
+
+            members[count].pid = pid;
+            members[count].start_time = start_time;
+            count++;
+            changed = true;
+        }
+    }
+
+    // 2. Bundle siblings (helpers launched by launchd, not by the app)
+    if (in_bundle) {
+        int32_t owner = os_get_owner_id(app->pid);
+
+        for (int i = 0; i < snapshot_count && count < MAX_GROUP_MEMBERS; i++) {
+            int32_t pid = snapshot[i].pid;
+            if (pid <= 1 || find_member(members, count, pid) >= 0) continue;
+            if (os_get_owner_id(pid) != owner) continue; // Another user's copy of the app
+
+            char other_key[MAX_PROC_PATH];
+            if (!app_key(pid, other_key, sizeof(other_key)) || strcmp(other_key, key) != 0) continue;
+
+            uint64_t start_time = os_get_process_start_time(pid);
+            if (start_time == 0 || skip_process(pid, skip)) continue;
+
+            members[count].pid = pid;
+            members[count].start_time = start_time;
+            count++;
+        }
+    }
+
+    // 3. Keep what we did to members we already knew (same process, not just same PID).
+    // One we changed stays in the group until the action is undone, even if it left.
+    for (int i = 0; i < app->member_count; i++) {
+        const GroupMember* old = &app->members[i];
+        int index = find_member(members, count, old->pid);
+
+        if (index >= 0 && members[index].start_time == old->start_time) {
+            members[index].saved_priority = old->saved_priority;
+            members[index].applied = old->applied;
+        }
+        else if (index < 0 && old->applied && count < MAX_GROUP_MEMBERS &&
+                 os_get_process_start_time(old->pid) == old->start_time) {
+            members[count++] = *old;
+        }
+    }
+
+    // Count last: a reader never sees members that are not written yet
+    memcpy(app->members, members, sizeof(GroupMember) * (size_t)count);
+    app->member_count = count;
+    app->members_refreshed = time(NULL);
+}
+
+bool group_contains(const AppState* app, int32_t pid) {
+    if (pid <= 0) return false;
+    return find_member(app->members, app->member_count, pid) >= 0;
+}
+
+void group_sample(AppState* app, time_t now) {
+    uint64_t memory = 0;
+    uint64_t cpu = 0;
+
+    for (int i = 0; i < app->member_count; i++) {
+        memory += os_get_memory_usage(app->members[i].pid);
+        cpu += os_get_cpu_time(app->members[i].pid);
+    }
+
+    // A member exiting makes the total go backwards, skip that sample
+    double seconds = difftime(now, app->sampled_at);
+    if (app->sampled_at > 0 && seconds > 0 && cpu >= app->cpu_time_ns) {
+        app->cpu_percent = (double)(cpu - app->cpu_time_ns) / 1e9 / seconds * 100.0;
+    }
+    else {
+        app->cpu_percent = 0.0;
+    }
+
+    app->memory_bytes = memory;
+    app->cpu_time_ns = cpu;
+    app->sampled_at = now;
+}
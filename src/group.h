@@ -0,0 +1,59 @@
+#ifndef GROUP_H
+#define GROUP_H
+
+#include "app_state.h"
+
+// How often (seconds) we look for new/dead helpers of a running app
+#define GROUP_REFRESH_SECONDS 5
+
+// Largest process table we look at in one snapshot
+#define MAX_PROCESSES 8192
+
+/**
+ * ----------------------------------------------------------------------
+ * APPLICATION GROUPS
+ * ----------------------------------------------------------------------
+ * Modern apps are a launcher plus a pile of helpers (renderers, GPU,
+ * plugins). The window belongs to one PID, the memory to all of them.
+ * A group is:
+ *   1. The leader: climb the parent chain while the parent is the same
+ *      app (same .app bundle, or same executable) owned by the same user.
+ *   2. Every descendant of the leader that is the same app (so a shell
+ *      or an IDE doesn't swallow everything it launched).
+ *   3. On macOS, every process of the same user running from inside
+ *      the leader's .app bundle (XPC services are children of launchd).
+ * ----------------------------------------------------------------------
+ */
+
+/**
+ * @brief Makes the next group call re-read the process table.
+ * * Normally the snapshot is reused for the rest of the current second.
+ */
+void group_invalidate_snapshot(void);
+
+/**
+ * @brief Finds the top process of the app that owns 'pid'.
+ * @return int32_t The leader PID ('pid' itself if it has no same-app parent).
+ */
+int32_t group_find_leader(int32_t pid);
+
+/**
+ * @brief Re-scans the process table and rebuilds app->members.
+ * * Members that stay keep their saved_priority/applied state, and a member
+ * * the action was applied to is kept (while alive) until it is undone.
+ * * @param app Slot with pid/start_time of the leader already set.
+ * @param skip Optional filter, members for which skip(name, exe_path) returns true are left out.
+ */
+void group_refresh(AppState* app, bool (*skip)(const char* name, const char* exe_path));
+
+/**
+ * @brief True if 'pid' is the leader or one of its helpers.
+ */
+bool group_contains(const AppState* app, int32_t pid);
+
+/**
+ * @brief Sums memory and CPU time over all members and updates cpu_percent.
+ */
+void group_sample(AppState* app, time_t now);
+
+#endif // GROUP_H
@@ -0,0 +1,48 @@
+#include <string.h>
+#include "journal.h"
+
+// "MNAP" in ASCII, so the file is recognisable in a hex dump
+#define JOURNAL_MAGIC   0x4D4E4150u
+// Bump this whenever AppState or JournalFile change layout
+#define JOURNAL_VERSION 5u
+
+// --- ON-DISK LAYOUT ---
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t slot_count;
+    uint32_t record_size;   // sizeof(AppState), catches compiler/ABI differences
+    AppState slots[MAX_TRACKED_APPS];
+} JournalFile;
+
+static JournalFile* journal = NULL;
+
+AppState* journal_open(const char* path, bool* already_running) {
+    *already_running = false;
+    if (journal != NULL) return journal->slots;
+
+    journal = (JournalFile*)os_map_file(path, sizeof(JournalFile), already_running);
+    if (journal == NULL) return NULL;
+
+    // A fresh file reads back as zeros. A foreign/old file has the wrong header.
+    // Either way we can't trust the slots, so start with an empty table.
+    if (journal->magic != JOURNAL_MAGIC ||
+        journal->version != JOURNAL_VERSION ||
+        journal->slot_count != MAX_TRACKED_APPS ||
+        journal->record_size != sizeof(AppState)) {
+        memset(journal, 0, sizeof(JournalFile));
+        journal->version = JOURNAL_VERSION;
+        journal->slot_count = MAX_TRACKED_APPS;
+        journal->record_size = sizeof(AppState);
+        // Write the magic last: a half-written header never looks valid
+        journal->magic = JOURNAL_MAGIC;
+    }
+
+    return journal->slots;
+}
+
+void journal_close(void) {
+    if (journal == NULL) return;
+    os_unmap_file(journal, sizeof(JournalFile));
+    journal = NULL;
+}
@@ -0,0 +1,34 @@
+#ifndef JOURNAL_H
+#define JOURNAL_H
+
+#include "app_state.h"
+
+#define JOURNAL_FILENAME "macnap.state"
+
+/**
+ * ----------------------------------------------------------------------
+ * THE CRASH-SAFE STATE JOURNAL
+ * ----------------------------------------------------------------------
+ * The history[] table lives inside a memory-mapped file. Every field
+ * we write (frozen flag, timers, PIDs) is an in-place memory write that
+ * the OS keeps even if MacNap is killed with SIGKILL or crashes.
+ * On the next start we read the table back and re-adopt the apps.
+ * ----------------------------------------------------------------------
+ */
+
+/**
+ * @brief Maps the journal file and returns its slot table.
+ * * A file with a wrong magic/version (or a brand new file) is wiped clean.
+ * * The file stays locked while open, so only one MacNap can own it.
+ * * @param path The state file to use (use JOURNAL_FILENAME).
+ * @param already_running Set to true if another MacNap holds the file.
+ * @return AppState* Array of MAX_TRACKED_APPS slots, or NULL if mapping failed.
+ */
+AppState* journal_open(const char* path, bool* already_running);
+
+/**
+ * @brief Flushes and unmaps the journal. Safe to call when not open.
+ */
+void journal_close(void);
+
+#endif // JOURNAL_H
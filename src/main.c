@@ -5,9 +5,14 @@
 #include <ctype.h>
 #include <signal.h>
 #include "os_interface.h"
-
-// --- CONFIGURATION DEFAULTS ---
-#define MAX_TRACKED_APPS 7
+#include "app_state.h"
+#include "journal.h"
+#include "policy.h"
+#include "group.h"
+#include "status.h"
+
+// --- LEGACY CONFIGURATION ---
+// Old "%d %d" file (timeout, min memory). Only read once to seed macnap.policy.
 #define CONFIG_FILENAME "macnap.conf"
 
 // --- LOG FILE ---
@@ -22,6 +27,9 @@ int user_whitelist_count = 0;
 // Runtime Flags
 bool flag_dry_run = false; // If true, we observe but do not freeze
 
+// Set by the signal handler, the main loop does the actual shutdown
+volatile sig_atomic_t exit_signal = 0;
+
 // --- ANSI COLORS ---
 #define COLOR_RESET   "\033[0m"
 #define COLOR_RED     "\033[31m"    // Freezing / Interface
@@ -30,10 +38,6 @@ bool flag_dry_run = false; // If true, we observe but do not freeze
 #define COLOR_CYAN    "\033[36m"    // Info / Stats
 #define COLOR_BOLD    "\033[1m"     // Headers
 
-// Runtime Configuration
-int config_timeout = 10;      // seconds
-int config_min_memory = 50;   // MB
-
 // Session Statistics
 int stats_frozen_count = 0;
 uint64_t stats_ram_saved_mb = 0;
@@ -48,15 +52,10 @@ uint64_t stats_ram_saved_mb = 0;
 #endif
 
 // --- DATA STRUCTURES ---
-typedef struct {
-    int32_t pid;
-    char name[MAX_PROC_NAME];
-    time_t last_active_time;
-    bool is_frozen;
-    bool valid; 
-} AppState;
-
-AppState history[MAX_TRACKED_APPS];
+// history points into the memory-mapped journal (see journal.h).
+// If the state file can't be mapped we fall back to plain RAM.
+AppState history_fallback[MAX_TRACKED_APPS];
+AppState* history = history_fallback;
 
 // --- HELPER: INPUT CLEANING ---
 void clear_input_buffer() {
@@ -65,28 +64,25 @@ void clear_input_buffer() {
 }
 
 // --- FILE I/O HELPERS ---
-void save_config() {
-    FILE *f = fopen(CONFIG_FILENAME, "w"); 
-    if (f == NULL) {
-        printf(COLOR_YELLOW "[WARN] Could not save configuration file." COLOR_RESET "\n");
+void save_policy() {
+    if (!policy_save(POLICY_FILENAME)) {
+        printf(COLOR_YELLOW "[WARN] Could not save policy file." COLOR_RESET "\n");
         return;
     }
-    fprintf(f, "%d %d", config_timeout, config_min_memory);
-    fclose(f);
-    printf(COLOR_CYAN "[DATA] Settings saved to '%s'" COLOR_RESET "\n", CONFIG_FILENAME);
+    printf(COLOR_CYAN "[DATA] Settings saved to '%s'" COLOR_RESET "\n", POLICY_FILENAME);
 }
 
-bool load_config() {
+// Seeds the default rule from an old macnap.conf, if there is one
+bool load_legacy_config() {
     FILE *f = fopen(CONFIG_FILENAME, "r"); 
     if (f == NULL) return false;
 
-    if (fscanf(f, "%d %d", &config_timeout, &config_min_memory) == 2) {
-        fclose(f);
-        return true; 
-    }
-
+    int timeout, min_memory;
+    bool ok = (fscanf(f, "%d %d", &timeout, &min_memory) == 2);
     fclose(f);
-    return false; 
+
+    if (ok) policy_set_defaults(timeout, min_memory);
+    return ok;
 }
 
 // --- WHITELIST LOADER ---
@@ -155,6 +151,13 @@ bool is_critical_process(const char* name) {
     return false;
 }
 
+// Group filter: helpers that are critical, or that have their own
+// "never" rule, are left out of the app (rules only match the leader)
+bool is_excluded_member(const char* name, const char* exe_path) {
+    if (is_critical_process(name)) return true;
+    return policy_rule(policy_resolve(name, exe_path))->action == POLICY_NEVER;
+}
+
 // LOGGING SYSTEM
 void write_log(const char* level, const char* message) {
     FILE *f = fopen(LOG_FILENAME, "a"); // 'a' = append mode
@@ -180,14 +183,96 @@ void send_notification(const char* title, const char* message) {
     system(command);
 }
 
+// --- POLICY ACTIONS ---
+// False once the PID has exited or been recycled for another process
+bool member_is_alive(const GroupMember* member) {
+    uint64_t start_time = os_get_process_start_time(member->pid);
+    return start_time != 0 && start_time == member->start_time;
+}
+
+// One action on one process. enable=false undoes it.
+// A member that is no longer the process we saw is never touched.
+int act_on_process(GroupMember* member, int action, bool enable) {
+    if (!member_is_alive(member)) return -1;
+
+    switch (action) {
+        case POLICY_THROTTLE:
+            return os_throttle_process(member->pid, enable, &member->saved_priority);
+        case POLICY_RECLAIM:
+            // Nothing to undo, pages come back when the app touches them
+            return enable ? os_reclaim_memory(member->pid) : 0;
+        default:
+            return enable ? os_freeze_process(member->pid) : os_thaw_process(member->pid);
+    }
+}
+
+// Apply the rule's action to every process of the app. Journal first:
+// if we are killed right after SIGSTOP, the restart must know this app is frozen.
+int apply_action(AppState* app, PolicyAction action) {
+    app->action = action;
+    app->frozen_since = time(NULL);
+    app->is_frozen = true;
+
+    int done = 0;
+    for (int m = 0; m < app->member_count; m++) {
+        GroupMember* member = &app->members[m];
+        member->applied = true;
+        int result = act_on_process(member, app->action, true);
+
+        // Not every OS can trim another process (macOS can't), throttle instead
+        if (result != 0 && m == 0 && app->action == POLICY_RECLAIM) {
+            app->action = POLICY_THROTTLE;
+            result = act_on_process(member, app->action, true);
+        }
+        member->applied = (result == 0);
+        if (result == 0) done++;
+    }
+
+    if (done == 0) {
+        app->is_frozen = false;
+        return -1;
+    }
+    return 0;
+}
+
+// Undo whatever apply_action did, on the members it worked on. Act first, clear the flag after.
+void release_app(AppState* app) {
+    for (int m = 0; m < app->member_count; m++) {
+        GroupMember* member = &app->members[m];
+        if (!member->applied) continue;
+        act_on_process(member, app->action, false);
+        member->applied = false;
+    }
+    app->is_frozen = false;
+}
+
+// A throttled or reclaimed app keeps running: helpers it started since get
+// the action too, and reclaim trims everyone again (the pages come back)
+void reapply_action(AppState* app) {
+    for (int m = 0; m < app->member_count; m++) {
+        GroupMember* member = &app->members[m];
+        if (member->applied && app->action != POLICY_RECLAIM) continue;
+
+        member->applied = true;
+        member->applied = (act_on_process(member, app->action, true) == 0);
+    }
+}
+
+const char* action_verb(int action) {
+    switch (action) {
+        case POLICY_THROTTLE: return "Throttled";
+        case POLICY_RECLAIM:  return "Reclaimed";
+        default:              return "Froze";
+    }
+}
+
 // BUG FIXING FUNCTION
 void perform_speculative_thaw() {
     bool thawed_something = false;
     for (int i = 0; i < MAX_TRACKED_APPS; i++) {
         if (history[i].valid && history[i].is_frozen) {
             // Unfreeze everything so the user can enter
-            os_thaw_process(history[i].pid);
-            history[i].is_frozen = false;
+            release_app(&history[i]);
 
             // Reset timer
             history[i].last_active_time = time(NULL);
@@ -211,6 +296,20 @@ void perform_speculative_thaw() {
 
 // --- CORE LOGIC ---
 
+void mark_app_active(AppState* app) {
+    app->last_active_time = time(NULL); 
+    
+    if (app->is_frozen) {
+        // GREEN for Thawing
+        printf(COLOR_GREEN "[ACTION] Welcome back, %s (PID %d). Thawing..." COLOR_RESET "\n", app->name, app->pid);
+        release_app(app);
+
+        char log_msg[128];
+        snprintf(log_msg, sizeof(log_msg), "Thawed %s (User Active)", app->name);
+        write_log("THAW", log_msg);
+    }
+}
+
 void update_app_activity(int32_t pid) {
     char name[MAX_PROC_NAME];
     os_get_process_name(pid, name, MAX_PROC_NAME);
@@ -220,23 +319,30 @@ void update_app_activity(int32_t pid) {
         return; 
     }
 
-    // Check existing
+    // Check existing: focus on ANY process of the app counts
     for (int i = 0; i < MAX_TRACKED_APPS; i++) {
-        if (history[i].valid && history[i].pid == pid) {
-            history[i].last_active_time = time(NULL); 
-            
-            if (history[i].is_frozen) {
-                // GREEN for Thawing
-                printf(COLOR_GREEN "[ACTION] Welcome back, %s (PID %d). Thawing..." COLOR_RESET "\n", history[i].name, pid);
-                os_thaw_process(pid);
-                history[i].is_frozen = false;
+        if (history[i].valid && group_contains(&history[i], pid)) {
+            mark_app_active(&history[i]);
+            return;
+        }
+    }
 
-                char log_msg[128];
-                snprintf(log_msg, sizeof(log_msg), "Thawed %s (User Active)", history[i].name);
-                write_log("THAW", log_msg);
+    // Not a known member. Find the app it belongs to.
+    int32_t leader = group_find_leader(pid);
+    if (leader != pid) {
+        for (int i = 0; i < MAX_TRACKED_APPS; i++) {
+            if (history[i].valid && history[i].pid == leader) {
+                // A helper we haven't seen yet, pick it up right away
+                if (!history[i].is_frozen) group_refresh(&history[i], is_excluded_member);
+                mark_app_active(&history[i]);
+                return;
             }
-            return;
         }
+
+        // We track the app by its leader
+        pid = leader;
+        os_get_process_name(pid, name, MAX_PROC_NAME);
+        if (is_critical_process(name)) return;
     }
 
     // Add new (Smart Eviction)
@@ -246,19 +352,37 @@ void update_app_activity(int32_t pid) {
         // YELLOW for Warning
         printf(COLOR_YELLOW "[WARN] History full! Evicting frozen app %s (PID %d). Thawing first..." COLOR_RESET "\n", 
                history[next_slot].name, history[next_slot].pid);
-        os_thaw_process(history[next_slot].pid);
-        history[next_slot].is_frozen = false;
+        release_app(&history[next_slot]);
     }
     
+    // Resolve the policy once, the slot caches it from now on
+    char path[MAX_PROC_PATH];
+    os_get_process_path(pid, path, MAX_PROC_PATH);
+    int rule = policy_resolve(name, path);
+
     // CYAN for Info
-    printf(COLOR_CYAN "[INFO] Tracking new app: %s (PID %d)" COLOR_RESET "\n", name, pid);
+    printf(COLOR_CYAN "[INFO] Tracking new app: %s (PID %d) [policy: %s]" COLOR_RESET "\n",
+           name, pid, policy_action_name(policy_rule(rule)->action));
     
+    // Journal order: invalidate, fill, then re-validate.
+    // If we die halfway, the slot is simply empty on restart.
+    history[next_slot].valid = false;
     history[next_slot].pid = pid;
+    history[next_slot].start_time = os_get_process_start_time(pid);
     strcpy(history[next_slot].name, name);
+    history[next_slot].rule = rule;
     history[next_slot].last_active_time = time(NULL);
     history[next_slot].is_frozen = false;
+    history[next_slot].sampled_at = 0;
+    history[next_slot].cpu_percent = 0.0;
+    history[next_slot].freeze_count = 0;
+    group_refresh(&history[next_slot], is_excluded_member);
     history[next_slot].valid = true;
 
+    if (history[next_slot].member_count > 1) {
+        printf(COLOR_CYAN "       (App group: %d processes)" COLOR_RESET "\n", history[next_slot].member_count);
+    }
+
     next_slot = (next_slot + 1) % MAX_TRACKED_APPS;
 }
 
@@ -268,15 +392,62 @@ void check_for_idlers() {
 
     for (int i = 0; i < MAX_TRACKED_APPS; i++) {
         if (!history[i].valid) continue;
-        if (history[i].is_frozen) continue; 
-        if (history[i].pid == active_pid) continue; 
 
-        // 1. Check Memory Usage
-        uint64_t mem_bytes = os_get_memory_usage(history[i].pid);
-        double mem_mb = (double)mem_bytes / (1024 * 1024);
+        // The app quit (or its PID now belongs to someone else): forget it.
+        // Helpers that outlived it are still ours to undo.
+        if (os_get_process_start_time(history[i].pid) != history[i].start_time) {
+            printf(COLOR_CYAN "[INFO] %s (PID %d) is gone. Dropping it." COLOR_RESET "\n",
+                   history[i].name, history[i].pid);
+            if (history[i].is_frozen) release_app(&history[i]);
+            history[i].valid = false;
+            continue;
+        }
+
+        const PolicyRule* rule = policy_rule(history[i].rule);
+
+        if (history[i].is_frozen) {
+            // 0. The Parole: never keep an app frozen longer than its rule allows
+            if (rule->max_frozen > 0 && difftime(now, history[i].frozen_since) > rule->max_frozen) {
+                printf(COLOR_GREEN "[POLICY] %s (PID %d) reached max_frozen (%ds). Thawing..." COLOR_RESET "\n",
+                       history[i].name, history[i].pid, rule->max_frozen);
+                release_app(&history[i]);
+
+                // It gets a full timeout before the next freeze
+                history[i].last_active_time = now;
+
+                char log_msg[128];
+                snprintf(log_msg, sizeof(log_msg), "Thawed %s (max_frozen reached)", history[i].name);
+                write_log("THAW", log_msg);
+                continue;
+            }
+
+            // Only a frozen app is really standing still
+            if (history[i].action != POLICY_FREEZE) {
+                if (difftime(now, history[i].members_refreshed) >= GROUP_REFRESH_SECONDS) {
+                    group_refresh(&history[i], is_excluded_member);
+                    reapply_action(&history[i]);
+                }
+                group_sample(&history[i], now);
+            }
+            continue;
+        }
+
+        // Keep the member list fresh while the app is running
+        if (difftime(now, history[i].members_refreshed) >= GROUP_REFRESH_SECONDS) {
+            group_refresh(&history[i], is_excluded_member);
+        }
+
+        // 1. Check Memory Usage (the whole app, not just the window owner).
+        // Sampled for every running app so the status page shows them all.
+        group_sample(&history[i], now);
+
+        if (group_contains(&history[i], active_pid)) continue; 
+        if (rule->action == POLICY_NEVER) continue;
+
+        double mem_mb = (double)history[i].memory_bytes / (1024 * 1024);
 
         // 2. The Gatekeeper
-        if (mem_mb < config_min_memory) {
+        if (mem_mb < rule->min_memory) {
             // Uncomment below if you want to see debug logs for small apps
             // printf("[IGNORE] %s is too small (%.1f MB)\n", history[i].name, mem_mb);
             continue;
@@ -285,10 +456,10 @@ void check_for_idlers() {
         double seconds_inactive = difftime(now, history[i].last_active_time);
 
         // 3. The Timeout
-        if (seconds_inactive > config_timeout) {
+        if (seconds_inactive > rule->timeout) {
             if (flag_dry_run) {
-                printf(COLOR_YELLOW "[DRY-RUN] Would have frozen %s (PID %d). Saving %.0f MB." COLOR_RESET "\n", 
-                       history[i].name, history[i].pid, mem_mb);
+                printf(COLOR_YELLOW "[DRY-RUN] Would have applied '%s' to %s (PID %d). Saving %.0f MB." COLOR_RESET "\n", 
+                       policy_action_name(rule->action), history[i].name, history[i].pid, mem_mb);
                 
                 // Reset timer so we don't spam the log every second
                 history[i].last_active_time = time(NULL);
@@ -296,14 +467,15 @@ void check_for_idlers() {
             }
 
             // RED for Freezing
-            printf(COLOR_RED "[Interface] %s (PID %d) inactive for %.0fs. Freezing!" COLOR_RESET "\n", 
-                   history[i].name, history[i].pid, seconds_inactive);
+            printf(COLOR_RED "[Interface] %s (PID %d, %d processes) inactive for %.0fs. Applying '%s'!" COLOR_RESET "\n", 
+                   history[i].name, history[i].pid, history[i].member_count, seconds_inactive,
+                   policy_action_name(rule->action));
             
-            if (os_freeze_process(history[i].pid) == 0) {
-                history[i].is_frozen = true;
-
-                // Update Statistics
+            if (apply_action(&history[i], rule->action) == 0) {
+                // Update Statistics (throttling keeps the memory, so it saves nothing)
                 stats_frozen_count++;
+                history[i].freeze_count++;
+                if (history[i].action == POLICY_THROTTLE) mem_mb = 0;
                 stats_ram_saved_mb += (uint64_t)mem_mb;
                 
                 // CYAN for Score
@@ -311,7 +483,7 @@ void check_for_idlers() {
 
                 // Send Notification
                 char msg[128];
-                snprintf(msg, sizeof(msg), "Froze %s (+%.0f MB RAM)", history[i].name, mem_mb);
+                snprintf(msg, sizeof(msg), "%s %s (+%.0f MB RAM)", action_verb(history[i].action), history[i].name, mem_mb);
                 send_notification("MacNap Interface", msg);
 
                 // --- DAY 11: BLACK BOX LOGGING ---
@@ -322,7 +494,15 @@ void check_for_idlers() {
 }
 
 // --- SIGNAL HANDLER ---
+// Only raise the flag. A signal can land while the loop is inside printf,
+// write_log or malloc, and calling those again from here would deadlock
+// on their locks with every frozen app still stopped.
 void handle_exit(int sig) {
+    exit_signal = sig;
+}
+
+// Runs in normal context once the main loop has seen exit_signal
+void shutdown_cleanly(int sig) {
     printf("\n\n");
     printf(COLOR_BOLD "========================================\n");
     printf("   SESSION REPORT 📊\n");
@@ -336,13 +516,132 @@ void handle_exit(int sig) {
     for (int i = 0; i < MAX_TRACKED_APPS; i++) {
         if (history[i].valid && history[i].is_frozen) {
             printf(COLOR_GREEN "[RESTORE] Emergency Thaw: %s (PID %d)" COLOR_RESET "\n", history[i].name, history[i].pid);
-            os_thaw_process(history[i].pid);
-            history[i].is_frozen = false;
+            release_app(&history[i]);
         }
     }
 
+    // Nothing is frozen anymore, the journal only keeps the warm history.
+    // Move history off the mapping first so nothing can touch unmapped memory.
+    if (history != history_fallback) {
+        memcpy(history_fallback, history, sizeof(history_fallback));
+        history = history_fallback;
+    }
+    journal_close();
+    status_close();
+
+    char log_msg[64];
+    snprintf(log_msg, sizeof(log_msg), "Clean shutdown (signal %d)", sig);
+    write_log("SYSTEM", log_msg);
+
     printf("[DONE] All Processes Restored. Exiting safely. Bye!\n\n");
-    exit(0);
+}
+
+void install_exit_handlers() {
+    #ifdef _WIN32
+        signal(SIGINT, handle_exit);
+        signal(SIGTERM, handle_exit);
+    #else
+        // No SA_RESTART: a signal cuts the loop's sleep short, so we stop right away
+        struct sigaction action;
+        memset(&action, 0, sizeof(action));
+        action.sa_handler = handle_exit;
+        sigemptyset(&action.sa_mask);
+
+        sigaction(SIGINT, &action, NULL);
+        sigaction(SIGTERM, &action, NULL);
+        sigaction(SIGHUP, &action, NULL);
+    #endif
+}
+
+// --- WARM RESTART ---
+// Re-adopt whatever the previous run left in the journal.
+// Apps that were frozen when we got killed are either kept (still ours)
+// or thawed, so nothing stays stopped forever.
+void recover_from_journal() {
+    bool already_running = false;
+    AppState* slots = journal_open(JOURNAL_FILENAME, &already_running);
+    if (already_running) {
+        // Two instances would fight over the same apps (and the status page)
+        printf(COLOR_RED "[ERROR] Another MacNap is already running ('%s' is locked)." COLOR_RESET "\n",
+               JOURNAL_FILENAME);
+        exit(1);
+    }
+    if (slots == NULL) {
+        printf(COLOR_YELLOW "[WARN] Could not map '%s'. State will not survive a crash." COLOR_RESET "\n",
+               JOURNAL_FILENAME);
+        return;
+    }
+
+    // Hand over anything already tracked (normally nothing at this point)
+    history = slots;
+
+    int adopted = 0;
+    int thawed = 0;
+    int dropped = 0;
+
+    for (int i = 0; i < MAX_TRACKED_APPS; i++) {
+        if (!history[i].valid) continue;
+
+        // 1. Which members are still the same process? (PIDs get recycled)
+        // Gone, or the PID now belongs to someone else: never signal it.
+        int alive = 0;
+        for (int m = 0; m < history[i].member_count; m++) {
+            GroupMember member = history[i].members[m];
+            uint64_t start_time = os_get_process_start_time(member.pid);
+            if (start_time != 0 && start_time == member.start_time) {
+                history[i].members[alive++] = member;
+            }
+        }
+        bool leader_alive = (alive > 0 && history[i].members[0].pid == history[i].pid);
+        history[i].member_count = alive;
+
+        if (!leader_alive) {
+            // The app is gone, but its helpers may still be frozen
+            if (history[i].is_frozen && alive > 0) {
+                printf(COLOR_GREEN "[RESTORE] Thawing %d orphaned helpers of %s" COLOR_RESET "\n",
+                       alive, history[i].name);
+                release_app(&history[i]);
+                thawed++;
+            }
+            history[i].valid = false;
+            history[i].is_frozen = false;
+            dropped++;
+            continue;
+        }
+        // We saw nothing while we were down: every app starts a fresh timeout,
+        // and the first CPU sample after the restart has no baseline yet
+        history[i].last_active_time = time(NULL);
+        history[i].sampled_at = 0;
+        history[i].cpu_time_ns = 0;
+        history[i].cpu_percent = 0.0;
+
+        // 2. The policy file may have changed since, resolve again
+        char path[MAX_PROC_PATH];
+        os_get_process_path(history[i].pid, path, MAX_PROC_PATH);
+        history[i].rule = policy_resolve(history[i].name, path);
+        bool never = (policy_rule(history[i].rule)->action == POLICY_NEVER);
+
+        // 3. Things that must not stay frozen under the new settings
+        if (history[i].is_frozen && (flag_dry_run || never || is_critical_process(history[i].name))) {
+            printf(COLOR_GREEN "[RESTORE] Thawing leftover: %s (PID %d)" COLOR_RESET "\n",
+                   history[i].name, history[i].pid);
+            release_app(&history[i]);
+            thawed++;
+        }
+        else if (history[i].is_frozen) {
+            printf(COLOR_CYAN "[RESTORE] Re-adopted frozen app: %s (PID %d)" COLOR_RESET "\n",
+                   history[i].name, history[i].pid);
+        }
+        adopted++;
+    }
+
+    if (adopted + dropped > 0) {
+        char log_msg[128];
+        snprintf(log_msg, sizeof(log_msg), "Warm restart: %d adopted (%d thawed), %d stale dropped",
+                 adopted, thawed, dropped);
+        write_log("SYSTEM", log_msg);
+        printf(COLOR_CYAN "[DATA] %s" COLOR_RESET "\n", log_msg);
+    }
 }
 
 // --- Daemonizer ---
@@ -386,7 +685,7 @@ void daemonize() {
 
 // --- MAIN LOOP ---
 int main(int argc, char* argv[]) {
-    signal(SIGINT, handle_exit);
+    install_exit_handlers();
 
     // 1. PARSE ARGUMENTS
     bool force_setup = false;
@@ -396,7 +695,7 @@ int main(int argc, char* argv[]) {
         if (strcmp(argv[i], "--help") == 0) {
             printf("\nMacNap Usage:\n");
             printf("  ./MacNap            Run normally\n");
-            printf("  ./MacNap --setup    Force configuration menu\n");
+            printf("  ./MacNap --setup    Interactive setup of the default rule\n");
             printf("  ./MacNap --dry-run  Safe mode (No freezing)\n");
             printf("  ./MacNap --help     Show this message\n\n");
             printf("  ./MacNap --daemon   Run in background (no terminal output)\n\n");
@@ -417,33 +716,50 @@ int main(int argc, char* argv[]) {
     printf("========================================\n" COLOR_RESET);
 
     // 2. CONFIGURATION
-    if (!force_setup && load_config()) {
-        printf("   > Mode: AUTOMATIC (Loaded from 'macnap.conf')\n");
-    } 
-    else {
-        if (force_setup) printf("   > Mode: FORCED SETUP\n");
-        else             printf("   > Mode: FIRST RUN SETUP\n");
+    // Never block on input unless asked to: a missing policy means defaults.
+    bool policy_found = policy_load(POLICY_FILENAME);
 
+    if (force_setup) {
+        printf("   > Mode: FORCED SETUP\n");
         printf("----------------------------------------\n");
+        const PolicyRule* defaults = policy_rule(POLICY_DEFAULT);
+        int timeout = defaults->timeout;
+        int min_memory = defaults->min_memory;
         int input_val;
 
-        printf("[1] Enter Freeze Timeout (Seconds) [Default: 10]: ");
-        if (scanf("%d", &input_val) == 1 && input_val > 0) config_timeout = input_val;
+        printf("[1] Enter Freeze Timeout (Seconds) [Current: %d]: ", timeout);
+        if (scanf("%d", &input_val) == 1 && input_val > 0) timeout = input_val;
         else clear_input_buffer(); 
 
-        printf("[2] Enter Minimum RAM to Freeze (MB) [Default: 50]: ");
-        if (scanf("%d", &input_val) == 1 && input_val > 0) config_min_memory = input_val;
+        printf("[2] Enter Minimum RAM to Freeze (MB) [Current: %d]: ", min_memory);
+        if (scanf("%d", &input_val) == 1 && input_val > 0) min_memory = input_val;
         else clear_input_buffer();
 
-        save_config();
+        policy_set_defaults(timeout, min_memory);
+        save_policy();
+    }
+    else if (policy_found) {
+        printf("   > Mode: AUTOMATIC (Loaded %d rules from '%s')\n", policy_rule_count(), POLICY_FILENAME);
+    }
+    else if (load_legacy_config()) {
+        printf("   > Mode: MIGRATED (Converted '%s' to '%s')\n", CONFIG_FILENAME, POLICY_FILENAME);
+        save_policy();
+    }
+    else {
+        printf("   > Mode: DEFAULTS (No '%s' found)\n", POLICY_FILENAME);
+        save_policy();
     }
 
     load_whitelist();
+    recover_from_journal();
 
     printf("\n" COLOR_BOLD "----------------------------------------\n");
     printf("   🚀 STARTING ENGINE...\n");
-    printf("   > Target: " COLOR_RED "Apps idle > %d sec" COLOR_RESET "\n", config_timeout);
-    printf("   > Filter: " COLOR_YELLOW "Apps > %d MB RAM" COLOR_RESET "\n", config_min_memory);
+    const PolicyRule* defaults = policy_rule(POLICY_DEFAULT);
+    printf("   > Target: " COLOR_RED "Apps idle > %d sec" COLOR_RESET "\n", defaults->timeout);
+    printf("   > Filter: " COLOR_YELLOW "Apps > %d MB RAM" COLOR_RESET "\n", defaults->min_memory);
+    printf("   > Rules:  " COLOR_CYAN "%d per-app rules (default: %s)" COLOR_RESET "\n",
+           policy_rule_count(), policy_action_name(defaults->action));
     if (flag_dry_run) printf("   > Mode:   " COLOR_YELLOW "DRY RUN (Simulation Only)" COLOR_RESET "\n");
     else              printf("   > System: " COLOR_GREEN "Sentinel & Notifications Active" COLOR_RESET "\n");
     printf("----------------------------------------\n" COLOR_RESET);
@@ -458,9 +774,18 @@ int main(int argc, char* argv[]) {
         write_log("SYSTEM", "Daemon Mode Activated (Detached from Terminal)");
         daemonize();
         // After daemonizing, we cannot print to terminal anymore
+
+        // daemonize() ignores SIGHUP while detaching, take it back
+        install_exit_handlers();
     }
 
-    while (1) {
+    // Publish live state for 'macnap_top' (after daemonize, so the PID is right)
+    if (!status_open(flag_dry_run)) {
+        write_log("WARN", "Could not create the status page, macnap_top will not work");
+    }
+
+    while (!exit_signal) {
+        uint64_t tick_start = os_get_time_ns();
         int32_t current_pid = os_get_active_pid();
         char current_name[MAX_PROC_NAME];
 
@@ -500,7 +825,12 @@ int main(int argc, char* argv[]) {
         }
 
         check_for_idlers();
+
+        status_publish(history, MAX_TRACKED_APPS, os_get_time_ns() - tick_start,
+                       stats_frozen_count, stats_ram_saved_mb);
         sleep_ms(1000); 
     }
+
+    shutdown_cleanly(exit_signal);
     return 0;
 }
\ No newline at end of file
@@ -8,6 +8,15 @@
 // Maximum length for a process name string
 #define MAX_PROC_NAME 256
 
+// Maximum length for a full executable path
+#define MAX_PROC_PATH 1024
+
+// One row of a process table snapshot
+typedef struct {
+    int32_t pid;
+    int32_t parent_pid;
+} ProcessEntry;
+
 /**
  * ----------------------------------------------------------------------
  * THE CROSS-PLATFORM CONTRACT
@@ -31,6 +40,37 @@ int32_t os_get_active_pid(void);
  */
 void os_get_process_name(int32_t pid, char* buffer, size_t size);
 
+/**
+ * @brief Gets the full path of the executable behind a PID.
+ * * Windows Implementation: Uses QueryFullProcessImageName.
+ * Mac Implementation: Uses proc_pidpath.
+ * * @param pid The Process ID to look up.
+ * @param buffer A character array to store the path (empty string on failure).
+ * @param size The size of the buffer (use MAX_PROC_PATH).
+ */
+void os_get_process_path(int32_t pid, char* buffer, size_t size);
+
+/**
+ * @brief Takes a snapshot of every process on the system with its parent.
+ * * Windows Implementation: CreateToolhelp32Snapshot (TH32CS_SNAPPROCESS).
+ * Mac Implementation: proc_listallpids + proc_bsdinfo (pbi_ppid).
+ * * @param entries Array to fill.
+ * @param max Capacity of the array.
+ * @return int Number of entries written. Returns -1 on error.
+ */
+int os_list_processes(ProcessEntry* entries, int max);
+
+/**
+ * @brief Returns an ID for the user the process runs as.
+ * * Two processes with the same ID belong to the same logged-in user.
+ * * Windows Implementation: ProcessIdToSessionId (one interactive user per session).
+ * Mac Implementation: pbi_uid from proc_bsdinfo (getsid is useless here,
+ * * launchd makes every job its own session leader).
+ * * @param pid The Process ID to check.
+ * @return int32_t Owner ID. Returns -1 on error.
+ */
+int32_t os_get_owner_id(int32_t pid);
+
 /**
  * @brief Freezes (pauses) the process execution.
  * * Windows Implementation: Iterates through threads and calls SuspendThread.
@@ -49,6 +89,38 @@ int os_freeze_process(int32_t pid);
  */
 int os_thaw_process(int32_t pid);
 
+/**
+ * @brief Moves the process to (or back from) background priority.
+ * * The process keeps running, it just loses every fight for the CPU.
+ * * Windows Implementation: GetPriorityClass + SetPriorityClass (IDLE, then the saved class).
+ * Mac Implementation: getpriority + setpriority(PRIO_DARWIN_PROCESS, PRIO_DARWIN_BG) (CPU + I/O throttling).
+ * * @param pid The Process ID to throttle.
+ * @param enable true to throttle, false to restore.
+ * @param saved_priority On enable, receives the original priority (written before
+ * *        the change). On restore, the value to put back.
+ * @return int 0 on success, non-zero on failure.
+ */
+int os_throttle_process(int32_t pid, bool enable, int32_t* saved_priority);
+
+/**
+ * @brief Asks the OS to take back the process's physical memory.
+ * * Windows Implementation: EmptyWorkingSet (pages move to the standby list).
+ * Mac Implementation: Not available (no API trims another task). Returns -1.
+ * * @param pid The Process ID to trim.
+ * @return int 0 on success, non-zero if unsupported or failed.
+ */
+int os_reclaim_memory(int32_t pid);
+
+/**
+ * @brief Asks the kernel if the process is currently stopped.
+ * * Freezing is asynchronous on some systems, so this is how we know it "took".
+ * * Windows Implementation: Probes each thread's suspend count (SuspendThread + ResumeThread).
+ * Mac Implementation: Reads pbi_status from proc_bsdinfo (SSTOP).
+ * * @param pid The Process ID to check.
+ * @return bool true if every thread is stopped, false if running or gone.
+ */
+bool os_is_process_frozen(int32_t pid);
+
 /**
  * @brief Returns the current memory usage of the process.
  * * Windows Implementation: Uses GetProcessMemoryInfo (Working Set).
@@ -58,4 +130,80 @@ int os_thaw_process(int32_t pid);
  */
 uint64_t os_get_memory_usage(int32_t pid);
 
+/**
+ * @brief Returns the total CPU time the process has used so far.
+ * * Windows Implementation: GetProcessTimes (Kernel + User time).
+ * Mac Implementation: proc_taskinfo (pti_total_user + pti_total_system).
+ * * @param pid The Process ID to check.
+ * @return uint64_t CPU time in Nanoseconds. Returns 0 on error.
+ */
+uint64_t os_get_cpu_time(int32_t pid);
+
+/**
+ * @brief Returns an opaque token for when the process was started.
+ * * Two processes with the same PID will (practically) never share a start time,
+ * * so comparing tokens tells us if a PID was recycled by the OS.
+ * * Windows Implementation: Uses GetProcessTimes (Creation Time).
+ * Mac Implementation: Uses proc_bsdinfo (pbi_start_tvsec/usec).
+ * * @param pid The Process ID to check.
+ * @return uint64_t Start time token. Returns 0 if the process does not exist.
+ */
+uint64_t os_get_process_start_time(int32_t pid);
+
+/**
+ * @brief Maps a file into memory (shared, read/write), creating it if needed.
+ * * Writes to the returned memory land in the OS page cache immediately,
+ * * so they survive even if our process is killed (SIGKILL, crash).
+ * * The file is also locked exclusively until os_unmap_file (or exit),
+ * * so a second MacNap can't map the same state.
+ * * Windows Implementation: LockFileEx + CreateFileMapping + MapViewOfFile.
+ * Mac Implementation: open + flock(LOCK_EX | LOCK_NB) + ftruncate + mmap(MAP_SHARED).
+ * * @param path The file to map.
+ * @param size Exact size of the mapping in Bytes (file is grown if smaller).
+ * @param already_locked Set to true if another process holds the lock.
+ * @return void* Base address of the mapping. Returns NULL on failure.
+ */
+void* os_map_file(const char* path, size_t size, bool* already_locked);
+
+/**
+ * @brief Flushes and releases a mapping created by os_map_file (and its lock).
+ * * @param base Address returned by os_map_file.
+ * @param size The same size passed to os_map_file.
+ */
+void os_unmap_file(void* base, size_t size);
+
+/**
+ * @brief Creates (or reuses) a named shared-memory segment for writing.
+ * * Windows Implementation: CreateFileMapping on the page file ("Local\\<name>", per session).
+ * Mac Implementation: shm_open("/<name>") + ftruncate + mmap(MAP_SHARED).
+ * * A segment that already exists but belongs to another user is rejected.
+ * * @param name Segment name without prefix (e.g., "macnap.status").
+ * @param size Size of the segment in Bytes.
+ * @return void* Base address. Returns NULL on failure.
+ */
+void* os_shm_create(const char* name, size_t size);
+
+/**
+ * @brief Maps an existing shared-memory segment read-only.
+ * * Only segments owned by us (or root) are accepted.
+ * * @param name The same name passed to os_shm_create.
+ * @param size Size of the segment in Bytes.
+ * @return const void* Base address. Returns NULL if it does not exist (yet).
+ */
+const void* os_shm_open_readonly(const char* name, size_t size);
+
+/**
+ * @brief Unmaps a segment from os_shm_create or os_shm_open_readonly.
+ * * The segment itself stays around for other readers.
+ */
+void os_shm_close(const void* base, size_t size);
+
+/**
+ * @brief Returns a monotonic clock reading (never jumps with wall-clock changes).
+ * * Windows Implementation: QueryPerformanceCounter.
+ * Mac Implementation: mach_absolute_time (converted with mach_timebase_info).
+ * * @return uint64_t Nanoseconds since an arbitrary fixed point.
+ */
+uint64_t os_get_time_ns(void);
+
 #endif // OS_INTERFACE_H
\ No newline at end of file
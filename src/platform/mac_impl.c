@@ -3,6 +3,15 @@
 #include <stdlib.h>
 #include <string.h>
 #include <signal.h>             // For kill(), SIGSTOP, SIGCONT
+#include <fcntl.h>              // For open()
+#include <unistd.h>             // For ftruncate(), close(), geteuid()
+#include <sys/mman.h>           // For mmap(), msync(), munmap(), shm_open()
+#include <sys/stat.h>           // For fstat()
+#include <sys/file.h>           // For flock()
+#include <errno.h>              // For errno, EWOULDBLOCK
+#include <sys/proc.h>           // For SSTOP
+#include <sys/resource.h>       // For setpriority(), PRIO_DARWIN_BG
+#include <mach/mach_time.h>     // For mach_timebase_info()
 #include <libproc.h>            // For process info (name, memory)
 #include <ApplicationServices/ApplicationServices.h> // For Window detection
 
@@ -54,6 +63,56 @@ void os_get_process_name(int32_t pid, char* buffer, size_t size) {
     }
 }
 
+void os_get_process_path(int32_t pid, char* buffer, size_t size) {
+    // proc_pidpath wants a PROC_PIDPATHINFO_MAXSIZE buffer, so go through our own
+    char path[PROC_PIDPATHINFO_MAXSIZE];
+    if (proc_pidpath(pid, path, sizeof(path)) <= 0) {
+        path[0] = '\0';
+    }
+    snprintf(buffer, size, "%s", path);
+}
+
+// --- 2b. PROCESS TABLE (libproc) ---
+int os_list_processes(ProcessEntry* entries, int max) {
+    // Ask how many PIDs exist, then fetch them (with headroom for new ones)
+    int needed = proc_listallpids(NULL, 0);
+    if (needed <= 0) return -1;
+
+    int capacity = needed + 64;
+    pid_t* pids = malloc(sizeof(pid_t) * (size_t)capacity);
+    if (pids == NULL) return -1;
+
+    int count = proc_listallpids(pids, capacity * (int)sizeof(pid_t));
+    if (count <= 0) {
+        free(pids);
+        return -1;
+    }
+
+    int written = 0;
+    for (int i = 0; i < count && written < max; i++) {
+        struct proc_bsdinfo bsd;
+        if (proc_pidinfo(pids[i], PROC_PIDTBSDINFO, 0, &bsd, sizeof(bsd)) != (int)sizeof(bsd)) {
+            continue; // Exited while we were looking
+        }
+        entries[written].pid = pids[i];
+        entries[written].parent_pid = (int32_t)bsd.pbi_ppid;
+        written++;
+    }
+
+    free(pids);
+    return written;
+}
+
+int32_t os_get_owner_id(int32_t pid) {
+    struct proc_bsdinfo bsd;
+
+    int ret = proc_pidinfo(pid, PROC_PIDTBSDINFO, 0, &bsd, sizeof(bsd));
+    if (ret != (int)sizeof(bsd)) {
+        return -1;
+    }
+    return (int32_t)bsd.pbi_uid;
+}
+
 // --- 3. MEMORY USAGE (libproc) ---
 uint64_t os_get_memory_usage(int32_t pid) {
     struct proc_taskinfo pti;
@@ -70,6 +129,27 @@ uint64_t os_get_memory_usage(int32_t pid) {
     return pti.pti_resident_size;
 }
 
+// --- 3b. CPU TIME (libproc) ---
+// Mach ticks -> ns (1 tick = 1ns on Intel, ~41ns on Apple Silicon)
+static uint64_t mach_ticks_to_ns(uint64_t ticks) {
+    static mach_timebase_info_data_t timebase = {0, 0};
+    if (timebase.denom == 0) mach_timebase_info(&timebase);
+    return ticks * timebase.numer / timebase.denom;
+}
+
+uint64_t os_get_cpu_time(int32_t pid) {
+    struct proc_taskinfo pti;
+    int ret = proc_pidinfo(pid, PROC_PIDTASKINFO, 0, &pti, sizeof(pti));
+    if (ret <= 0) return 0;
+
+    // The totals are in Mach ticks too
+    return mach_ticks_to_ns(pti.pti_total_user + pti.pti_total_system);
+}
+
+uint64_t os_get_time_ns(void) {
+    return mach_ticks_to_ns(mach_absolute_time());
+}
+
 // --- 4. FREEZE & THAW (Signals) ---
 int os_freeze_process(int32_t pid) {
     // Send SIGSTOP: Tells the scheduler to remove this process from the run queue
@@ -85,4 +165,168 @@ int os_thaw_process(int32_t pid) {
         return 0;
     }
     return -1;
-}
\ No newline at end of file
+}
+
+// --- 4b. GENTLER ACTIONS ---
+int os_throttle_process(int32_t pid, bool enable, int32_t* saved_priority) {
+    // PRIO_DARWIN_BG is what macOS uses for App Nap: low CPU priority + throttled disk I/O.
+    // Unlike plain nice(), we are allowed to undo it without root.
+    if (enable) {
+        // An app that was already in the background must stay there after the thaw
+        errno = 0;
+        int current = getpriority(PRIO_DARWIN_PROCESS, pid);
+        if (current == -1 && errno != 0) return -1;
+        *saved_priority = (current & PRIO_DARWIN_BG) ? PRIO_DARWIN_BG : 0;
+    }
+
+    int priority = enable ? PRIO_DARWIN_BG : *saved_priority;
+    if (setpriority(PRIO_DARWIN_PROCESS, pid, priority) == 0) {
+        return 0;
+    }
+    return -1;
+}
+
+int os_reclaim_memory(int32_t pid) {
+    // There is no public API to trim another task's resident set on macOS
+    (void)pid;
+    return -1;
+}
+
+bool os_is_process_frozen(int32_t pid) {
+    struct proc_bsdinfo bsd;
+
+    // kill() only queues the signal, pbi_status tells us when the stop really happened
+    int ret = proc_pidinfo(pid, PROC_PIDTBSDINFO, 0, &bsd, sizeof(bsd));
+    if (ret != (int)sizeof(bsd)) {
+        return false;
+    }
+    return bsd.pbi_status == SSTOP;
+}
+
+// --- 5. PROCESS IDENTITY (libproc) ---
+uint64_t os_get_process_start_time(int32_t pid) {
+    struct proc_bsdinfo bsd;
+
+    // PROC_PIDTBSDINFO holds the BSD view of the process, including when it started
+    int ret = proc_pidinfo(pid, PROC_PIDTBSDINFO, 0, &bsd, sizeof(bsd));
+    if (ret != (int)sizeof(bsd)) {
+        return 0; // Process is gone (or we are not allowed to look)
+    }
+
+    // Pack seconds + microseconds into one comparable number
+    return (uint64_t)bsd.pbi_start_tvsec * 1000000ULL + (uint64_t)bsd.pbi_start_tvusec;
+}
+
+// --- 6. STATE FILE (mmap) ---
+// The lock lives as long as the descriptor, so we keep it open per mapping
+#define MAX_LOCKED_FILES 4
+static struct { void* base; int fd; } locked_files[MAX_LOCKED_FILES];
+
+void* os_map_file(const char* path, size_t size, bool* already_locked) {
+    *already_locked = false;
+
+    int slot = -1;
+    for (int i = 0; i < MAX_LOCKED_FILES; i++) {
+        if (locked_files[i].base == NULL) {
+            slot = i;
+            break;
+        }
+    }
+    if (slot < 0) return NULL;
+
+    int fd = open(path, O_RDWR | O_CREAT, 0644);
+    if (fd < 0) return NULL;
+
+    // Non-blocking: if someone else has it, we want to know now, not wait
+    if (flock(fd, LOCK_EX | LOCK_NB) != 0) {
+        *already_locked = (errno == EWOULDBLOCK);
+        close(fd);
+        return NULL;
+    }
+
+    // Make sure the file is big enough (new bytes read back as zero)
+    if (ftruncate(fd, (off_t)size) != 0) {
+        close(fd);
+        return NULL;
+    }
+
+    // MAP_SHARED: our writes go straight to the page cache, not a private copy
+    void* base = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (base == MAP_FAILED) {
+        close(fd);
+        return NULL;
+    }
+
+    locked_files[slot].base = base;
+    locked_files[slot].fd = fd;
+    return base;
+}
+
+void os_unmap_file(void* base, size_t size) {
+    if (base == NULL) return;
+    msync(base, size, MS_SYNC);
+    munmap(base, size);
+
+    // Closing the descriptor drops the lock
+    for (int i = 0; i < MAX_LOCKED_FILES; i++) {
+        if (locked_files[i].base == base) {
+            close(locked_files[i].fd);
+            locked_files[i].base = NULL;
+        }
+    }
+}
+
+// --- 7. SHARED MEMORY (POSIX shm) ---
+void* os_shm_create(const char* name, size_t size) {
+    char path[64];
+    snprintf(path, sizeof(path), "/%s", name);
+
+    int fd = shm_open(path, O_RDWR | O_CREAT, 0644);
+    if (fd < 0) return NULL;
+
+    // The name is global: someone else may have created it first to feed our readers
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_uid != geteuid()) {
+        close(fd);
+        return NULL;
+    }
+
+    // macOS only lets you size a segment once, a reused one must already be big enough
+    if ((size_t)st.st_size < size && ftruncate(fd, (off_t)size) != 0) {
+        close(fd);
+        return NULL;
+    }
+
+    void* base = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+
+    if (base == MAP_FAILED) return NULL;
+    return base;
+}
+
+const void* os_shm_open_readonly(const char* name, size_t size) {
+    char path[64];
+    snprintf(path, sizeof(path), "/%s", name);
+
+    int fd = shm_open(path, O_RDONLY, 0);
+    if (fd < 0) return NULL;
+
+    // Only trust a page written by us (or by a MacNap running as root)
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (st.st_uid != geteuid() && st.st_uid != 0) ||
+        (size_t)st.st_size < size) {
+        close(fd);
+        return NULL;
+    }
+
+    void* base = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+
+    if (base == MAP_FAILED) return NULL;
+    return base;
+}
+
+void os_shm_close(const void* base, size_t size) {
+    if (base == NULL) return;
+    munmap((void*)base, size);
+}
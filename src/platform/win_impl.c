@@ -3,6 +3,7 @@
 #include <psapi.h>      // For memory and name info
 #include <tlhelp32.h>   // For snapshots (Freeze/Thaw logic)
 #include <stdio.h>
+#include <string.h>     // For memset
 
 // Helper to open a process with specific permissions
 HANDLE get_process_handle(int32_t pid) {
@@ -34,6 +35,46 @@ void os_get_process_name(int32_t pid, char* buffer, size_t size) {
     }
 }
 
+void os_get_process_path(int32_t pid, char* buffer, size_t size) {
+    buffer[0] = '\0';
+
+    HANDLE hProcess = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE, pid);
+    if (hProcess) {
+        DWORD length = (DWORD)size;
+        if (!QueryFullProcessImageNameA(hProcess, 0, buffer, &length)) {
+            buffer[0] = '\0';
+        }
+        CloseHandle(hProcess);
+    }
+}
+
+int os_list_processes(ProcessEntry* entries, int max) {
+    HANDLE hProcessSnap = CreateToolhelp32Snapshot(TH32CS_SNAPPROCESS, 0);
+    if (hProcessSnap == INVALID_HANDLE_VALUE) return -1;
+
+    PROCESSENTRY32 pe32;
+    pe32.dwSize = sizeof(PROCESSENTRY32);
+
+    int written = 0;
+    if (Process32First(hProcessSnap, &pe32)) {
+        do {
+            // Note: Windows never updates the parent PID, it may point to a dead (or reused) PID
+            entries[written].pid = (int32_t)pe32.th32ProcessID;
+            entries[written].parent_pid = (int32_t)pe32.th32ParentProcessID;
+            written++;
+        } while (written < max && Process32Next(hProcessSnap, &pe32));
+    }
+
+    CloseHandle(hProcessSnap);
+    return written;
+}
+
+int32_t os_get_owner_id(int32_t pid) {
+    DWORD session = 0;
+    if (!ProcessIdToSessionId((DWORD)pid, &session)) return -1;
+    return (int32_t)session;
+}
+
 uint64_t os_get_memory_usage(int32_t pid) {
     HANDLE hProcess = get_process_handle(pid);
     if (!hProcess) return 0;
@@ -98,4 +139,219 @@ int os_freeze_process(int32_t pid) {
 
 int os_thaw_process(int32_t pid) {
     return toggle_process_threads(pid, false); // false = thaw
-}
\ No newline at end of file
+}
+
+// --- GENTLER ACTIONS ---
+int os_throttle_process(int32_t pid, bool enable, int32_t* saved_priority) {
+    HANDLE hProcess = OpenProcess(PROCESS_SET_INFORMATION | PROCESS_QUERY_LIMITED_INFORMATION, FALSE, pid);
+    if (!hProcess) return -1;
+
+    if (enable) {
+        // Remember the real class (games run HIGH, some tools BELOW_NORMAL)
+        DWORD current = GetPriorityClass(hProcess);
+        if (current == 0) {
+            CloseHandle(hProcess);
+            return -1;
+        }
+        *saved_priority = (int32_t)current;
+    }
+
+    DWORD priority = enable ? IDLE_PRIORITY_CLASS : (DWORD)*saved_priority;
+    int result = SetPriorityClass(hProcess, priority) ? 0 : -1;
+
+    CloseHandle(hProcess);
+    return result;
+}
+
+int os_reclaim_memory(int32_t pid) {
+    HANDLE hProcess = OpenProcess(PROCESS_QUERY_INFORMATION | PROCESS_SET_QUOTA, FALSE, pid);
+    if (!hProcess) return -1;
+
+    // Pages are moved to the standby list, they come back on the next touch
+    int result = EmptyWorkingSet(hProcess) ? 0 : -1;
+
+    CloseHandle(hProcess);
+    return result;
+}
+
+bool os_is_process_frozen(int32_t pid) {
+    // Windows has no "stopped" flag for a process, only per-thread suspend counts.
+    // SuspendThread returns the previous count, so suspend + resume is a
+    // read that leaves the thread exactly as we found it.
+    HANDLE hThreadSnap = CreateToolhelp32Snapshot(TH32CS_SNAPTHREAD, 0);
+    if (hThreadSnap == INVALID_HANDLE_VALUE) return false;
+
+    THREADENTRY32 te32;
+    te32.dwSize = sizeof(THREADENTRY32);
+
+    bool seen_thread = false;
+    bool all_suspended = true;
+
+    if (Thread32First(hThreadSnap, &te32)) {
+        do {
+            if (te32.th32OwnerProcessID != (DWORD)pid) continue;
+
+            HANDLE hThread = OpenThread(THREAD_SUSPEND_RESUME, FALSE, te32.th32ThreadID);
+            if (hThread == NULL) continue;
+
+            DWORD previous = SuspendThread(hThread);
+            if (previous != (DWORD)-1) {
+                ResumeThread(hThread);
+                seen_thread = true;
+                if (previous == 0) all_suspended = false;
+            }
+            CloseHandle(hThread);
+        } while (all_suspended && Thread32Next(hThreadSnap, &te32));
+    }
+
+    CloseHandle(hThreadSnap);
+    return seen_thread && all_suspended;
+}
+
+// --- PROCESS IDENTITY ---
+uint64_t os_get_process_start_time(int32_t pid) {
+    HANDLE hProcess = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE, pid);
+    if (!hProcess) return 0;
+
+    FILETIME creation, exit_time, kernel, user;
+    uint64_t start = 0;
+
+    if (GetProcessTimes(hProcess, &creation, &exit_time, &kernel, &user)) {
+        // FILETIME is two 32-bit halves of a 100ns tick counter
+        start = ((uint64_t)creation.dwHighDateTime << 32) | creation.dwLowDateTime;
+    }
+
+    CloseHandle(hProcess);
+    return start;
+}
+
+uint64_t os_get_cpu_time(int32_t pid) {
+    HANDLE hProcess = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE, pid);
+    if (!hProcess) return 0;
+
+    FILETIME creation, exit_time, kernel, user;
+    uint64_t total = 0;
+
+    if (GetProcessTimes(hProcess, &creation, &exit_time, &kernel, &user)) {
+        uint64_t k = ((uint64_t)kernel.dwHighDateTime << 32) | kernel.dwLowDateTime;
+        uint64_t u = ((uint64_t)user.dwHighDateTime << 32) | user.dwLowDateTime;
+        total = (k + u) * 100; // 100ns ticks -> ns
+    }
+
+    CloseHandle(hProcess);
+    return total;
+}
+
+// --- STATE FILE ---
+// The lock lives as long as the file handle, so we keep it open per mapping
+#define MAX_LOCKED_FILES 4
+static struct { void* base; HANDLE hFile; } locked_files[MAX_LOCKED_FILES];
+
+void* os_map_file(const char* path, size_t size, bool* already_locked) {
+    *already_locked = false;
+
+    int slot = -1;
+    for (int i = 0; i < MAX_LOCKED_FILES; i++) {
+        if (locked_files[i].base == NULL) {
+            slot = i;
+            break;
+        }
+    }
+    if (slot < 0) return NULL;
+
+    HANDLE hFile = CreateFileA(path, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE,
+                               NULL, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (hFile == INVALID_HANDLE_VALUE) return NULL;
+
+    // Non-blocking exclusive lock on the whole file
+    OVERLAPPED region;
+    memset(&region, 0, sizeof(region));
+    if (!LockFileEx(hFile, LOCKFILE_EXCLUSIVE_LOCK | LOCKFILE_FAIL_IMMEDIATELY, 0, MAXDWORD, MAXDWORD, &region)) {
+        *already_locked = (GetLastError() == ERROR_LOCK_VIOLATION);
+        CloseHandle(hFile);
+        return NULL;
+    }
+
+    // The mapping object grows the file to 'size' if it is smaller
+    HANDLE hMap = CreateFileMappingA(hFile, NULL, PAGE_READWRITE,
+                                     (DWORD)((uint64_t)size >> 32), (DWORD)(size & 0xFFFFFFFF), NULL);
+    if (hMap == NULL) {
+        CloseHandle(hFile);
+        return NULL;
+    }
+
+    void* base = MapViewOfFile(hMap, FILE_MAP_ALL_ACCESS, 0, 0, size);
+
+    // The view keeps the mapping alive, we can drop that handle now
+    CloseHandle(hMap);
+    if (base == NULL) {
+        CloseHandle(hFile);
+        return NULL;
+    }
+
+    locked_files[slot].base = base;
+    locked_files[slot].hFile = hFile;
+    return base;
+}
+
+void os_unmap_file(void* base, size_t size) {
+    if (base == NULL) return;
+    FlushViewOfFile(base, size);
+    UnmapViewOfFile(base);
+
+    // Closing the file handle drops the lock
+    for (int i = 0; i < MAX_LOCKED_FILES; i++) {
+        if (locked_files[i].base == base) {
+            CloseHandle(locked_files[i].hFile);
+            locked_files[i].base = NULL;
+        }
+    }
+}
+
+// --- SHARED MEMORY ---
+void* os_shm_create(const char* name, size_t size) {
+    char path[64];
+    snprintf(path, sizeof(path), "Local\\%s", name);
+
+    // INVALID_HANDLE_VALUE = backed by the page file, not a real file
+    HANDLE hMap = CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE,
+                                     (DWORD)((uint64_t)size >> 32), (DWORD)(size & 0xFFFFFFFF), path);
+    if (hMap == NULL) return NULL;
+
+    void* base = MapViewOfFile(hMap, FILE_MAP_ALL_ACCESS, 0, 0, size);
+
+    // The view keeps the section alive as long as we are running
+    CloseHandle(hMap);
+    return base;
+}
+
+const void* os_shm_open_readonly(const char* name, size_t size) {
+    char path[64];
+    snprintf(path, sizeof(path), "Local\\%s", name);
+
+    HANDLE hMap = OpenFileMappingA(FILE_MAP_READ, FALSE, path);
+    if (hMap == NULL) return NULL;
+
+    const void* base = MapViewOfFile(hMap, FILE_MAP_READ, 0, 0, size);
+    CloseHandle(hMap);
+    return base;
+}
+
+void os_shm_close(const void* base, size_t size) {
+    (void)size;
+    if (base == NULL) return;
+    UnmapViewOfFile(base);
+}
+
+// --- CLOCK ---
+uint64_t os_get_time_ns(void) {
+    static LARGE_INTEGER freq = {0};
+    LARGE_INTEGER counter;
+    if (freq.QuadPart == 0) QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&counter);
+
+    // Split to avoid overflowing 64 bits on long uptimes
+    uint64_t seconds = (uint64_t)(counter.QuadPart / freq.QuadPart);
+    uint64_t rest = (uint64_t)(counter.QuadPart % freq.QuadPart);
+    return seconds * 1000000000ULL + rest * 1000000000ULL / (uint64_t)freq.QuadPart;
+}
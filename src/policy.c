@@ -0,0 +1,353 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <limits.h>
+#include "policy.h"
+
+// --- BUILT-IN DEFAULTS (used when there is no policy file) ---
+#define DEFAULT_TIMEOUT     10   // seconds
+#define DEFAULT_MIN_MEMORY  50   // MB
+
+// Open-addressing table for exact matches. Power of two, > 2x MAX_POLICY_RULES.
+#define HASH_SLOTS 128
+
+// A rule as written in the file. -1 means "not set, inherit from default".
+typedef struct {
+    PolicyMatch match;
+    char pattern[MAX_POLICY_PATTERN];
+    int timeout;
+    int min_memory;
+    int action;
+    int max_frozen;
+} RawRule;
+
+static RawRule raw_default = { MATCH_NAME, "", DEFAULT_TIMEOUT, DEFAULT_MIN_MEMORY, POLICY_FREEZE, 0 };
+static RawRule raw_rules[MAX_POLICY_RULES];
+static int rule_count = 0;
+
+// --- COMPILED FORM ---
+static PolicyRule compiled_default;
+static PolicyRule compiled_rules[MAX_POLICY_RULES];
+static int hash_table[HASH_SLOTS];           // rule index + 1, 0 = empty
+static int glob_rules[MAX_POLICY_RULES];     // indices of wildcard rules, in file order
+static int glob_count = 0;
+static bool compiled = false;
+
+static const char* action_names[] = { "freeze", "throttle", "reclaim", "never" };
+
+const char* policy_action_name(PolicyAction action) {
+    if (action < POLICY_FREEZE || action > POLICY_NEVER) return "unknown";
+    return action_names[action];
+}
+
+// --- HELPERS ---
+
+// FNV-1a, mixed with the match field so name=X and exe=X don't collide
+static uint32_t hash_key(PolicyMatch match, const char* text) {
+    uint32_t h = 2166136261u ^ (uint32_t)match;
+    for (const unsigned char* p = (const unsigned char*)text; *p; p++) {
+        h ^= *p;
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static bool is_glob(const char* pattern) {
+    return strpbrk(pattern, "*?") != NULL;
+}
+
+// '*' = any run of characters, '?' = exactly one character
+static bool glob_match(const char* pattern, const char* text) {
+    const char* star = NULL;
+    const char* resume = NULL;
+
+    while (*text) {
+        if (*pattern == '?' || *pattern == *text) {
+            pattern++;
+            text++;
+        }
+        else if (*pattern == '*') {
+            star = pattern++;
+            resume = text;
+        }
+        else if (star) {
+            // Let the last '*' swallow one more character and retry
+            pattern = star + 1;
+            text = ++resume;
+        }
+        else {
+            return false;
+        }
+    }
+    while (*pattern == '*') pattern++;
+    return *pattern == '\0';
+}
+
+static int inherit(int value, int fallback) {
+    return value >= 0 ? value : fallback;
+}
+
+// Turn raw_rules into compiled_rules + lookup tables
+static void policy_compile() {
+    compiled_default.match = MATCH_NAME;
+    compiled_default.pattern[0] = '\0';
+    compiled_default.timeout = raw_default.timeout;
+    compiled_default.min_memory = raw_default.min_memory;
+    compiled_default.action = (PolicyAction)raw_default.action;
+    compiled_default.max_frozen = raw_default.max_frozen;
+
+    memset(hash_table, 0, sizeof(hash_table));
+    glob_count = 0;
+
+    for (int i = 0; i < rule_count; i++) {
+        const RawRule* raw = &raw_rules[i];
+        PolicyRule* rule = &compiled_rules[i];
+
+        rule->match = raw->match;
+        strcpy(rule->pattern, raw->pattern);
+        rule->timeout = inherit(raw->timeout, compiled_default.timeout);
+        rule->min_memory = inherit(raw->min_memory, compiled_default.min_memory);
+        rule->action = (PolicyAction)inherit(raw->action, compiled_default.action);
+        rule->max_frozen = inherit(raw->max_frozen, compiled_default.max_frozen);
+
+        if (is_glob(rule->pattern)) {
+            glob_rules[glob_count++] = i;
+            continue;
+        }
+
+        // Exact pattern: insert unless an earlier rule already owns the key
+        uint32_t slot = hash_key(rule->match, rule->pattern) & (HASH_SLOTS - 1);
+        while (hash_table[slot] != 0) {
+            const PolicyRule* other = &compiled_rules[hash_table[slot] - 1];
+            if (other->match == rule->match && strcmp(other->pattern, rule->pattern) == 0) break;
+            slot = (slot + 1) & (HASH_SLOTS - 1);
+        }
+        if (hash_table[slot] == 0) hash_table[slot] = i + 1;
+    }
+
+    compiled = true;
+}
+
+static int lookup_exact(PolicyMatch match, const char* text) {
+    uint32_t slot = hash_key(match, text) & (HASH_SLOTS - 1);
+    while (hash_table[slot] != 0) {
+        const PolicyRule* rule = &compiled_rules[hash_table[slot] - 1];
+        if (rule->match == match && strcmp(rule->pattern, text) == 0) return hash_table[slot] - 1;
+        slot = (slot + 1) & (HASH_SLOTS - 1);
+    }
+    return INT_MAX;
+}
+
+// --- PARSER ---
+
+// Reads the next key=value pair. Values may be "quoted" to allow spaces.
+// Returns false at end of line, sets *error on malformed input.
+static bool next_pair(char** cursor, char** key, char** value, bool* error) {
+    char* p = *cursor;
+    while (*p == ' ' || *p == '\t') p++;
+    if (*p == '\0' || *p == '#') return false;
+
+    *key = p;
+    while (*p && *p != '=' && *p != ' ' && *p != '\t') p++;
+    if (*p != '=') {
+        *error = true;
+        return false;
+    }
+    *p++ = '\0';
+
+    if (*p == '"') {
+        *value = ++p;
+        while (*p && *p != '"') p++;
+        if (*p != '"') {
+            *error = true;
+            return false;
+        }
+        *p++ = '\0';
+    }
+    else {
+        *value = p;
+        while (*p && *p != ' ' && *p != '\t') p++;
+        if (*p) *p++ = '\0';
+    }
+
+    *cursor = p;
+    return true;
+}
+
+static bool parse_int(const char* text, int* out) {
+    char* end;
+    long value = strtol(text, &end, 10);
+    if (end == text || *end != '\0' || value < 0 || value > INT_MAX) return false;
+    *out = (int)value;
+    return true;
+}
+
+static bool parse_action(const char* text, int* out) {
+    for (int i = POLICY_FREEZE; i <= POLICY_NEVER; i++) {
+        if (strcmp(text, action_names[i]) == 0) {
+            *out = i;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Fills 'rule' from one line. Returns a short reason on error, NULL on success.
+static const char* parse_rule(char* cursor, RawRule* rule, bool is_default) {
+    char* key;
+    char* value;
+    bool error = false;
+    bool has_pattern = false;
+
+    while (next_pair(&cursor, &key, &value, &error)) {
+        if (strcmp(key, "name") == 0 || strcmp(key, "exe") == 0) {
+            if (is_default) return "'default' cannot have a name/exe";
+            if (has_pattern) return "only one name/exe per rule";
+            if (strlen(value) == 0 || strlen(value) >= MAX_POLICY_PATTERN) return "bad pattern length";
+            rule->match = (key[0] == 'n') ? MATCH_NAME : MATCH_EXE;
+            strcpy(rule->pattern, value);
+            has_pattern = true;
+        }
+        else if (strcmp(key, "timeout") == 0) {
+            if (!parse_int(value, &rule->timeout) || rule->timeout == 0) return "timeout must be > 0";
+        }
+        else if (strcmp(key, "min_memory") == 0) {
+            if (!parse_int(value, &rule->min_memory)) return "min_memory must be >= 0";
+        }
+        else if (strcmp(key, "max_frozen") == 0) {
+            if (!parse_int(value, &rule->max_frozen)) return "max_frozen must be >= 0";
+        }
+        else if (strcmp(key, "action") == 0) {
+            if (!parse_action(value, &rule->action)) return "action must be freeze/throttle/reclaim/never";
+        }
+        else {
+            return "unknown key";
+        }
+    }
+
+    if (error) return "expected key=value";
+    if (!is_default && !has_pattern) return "'app' needs name= or exe=";
+    return NULL;
+}
+
+// --- PUBLIC API ---
+
+bool policy_load(const char* path) {
+    FILE* f = fopen(path, "r");
+    if (f == NULL) {
+        policy_compile();
+        return false;
+    }
+
+    rule_count = 0;
+    char line[1024];
+    int line_number = 0;
+
+    while (fgets(line, sizeof(line), f)) {
+        line_number++;
+        line[strcspn(line, "\r\n")] = 0;
+
+        char* p = line;
+        while (*p == ' ' || *p == '\t') p++;
+        if (*p == '\0' || *p == '#') continue;
+
+        const char* reason = NULL;
+
+        if (strncmp(p, "default", 7) == 0 && (p[7] == ' ' || p[7] == '\t' || p[7] == '\0')) {
+            RawRule rule = raw_default;
+            reason = parse_rule(p + 7, &rule, true);
+            if (reason == NULL) raw_default = rule;
+        }
+        else if (strncmp(p, "app", 3) == 0 && (p[3] == ' ' || p[3] == '\t')) {
+            if (rule_count >= MAX_POLICY_RULES) {
+                reason = "too many rules";
+            }
+            else {
+                RawRule rule = { MATCH_NAME, "", -1, -1, -1, -1 };
+                reason = parse_rule(p + 3, &rule, false);
+                if (reason == NULL) raw_rules[rule_count++] = rule;
+            }
+        }
+        else {
+            reason = "line must start with 'default' or 'app'";
+        }
+
+        if (reason != NULL) {
+            printf("[WARN] %s:%d skipped (%s)\n", path, line_number, reason);
+        }
+    }
+    fclose(f);
+
+    policy_compile();
+    return true;
+}
+
+static void write_pair(FILE* f, const char* key, int value) {
+    if (value >= 0) fprintf(f, " %s=%d", key, value);
+}
+
+bool policy_save(const char* path) {
+    FILE* f = fopen(path, "w");
+    if (f == NULL) return false;
+
+    fprintf(f, "# MacNap policy. First matching 'app' rule wins, missing keys come from 'default'.\n");
+    fprintf(f, "#   app name=<process name|glob> | exe=\"<full path|glob>\"\n");
+    fprintf(f, "#       timeout=<sec> min_memory=<MB> action=freeze|throttle|reclaim|never max_frozen=<sec, 0=forever>\n");
+
+    fprintf(f, "default timeout=%d min_memory=%d action=%s max_frozen=%d\n",
+            raw_default.timeout, raw_default.min_memory,
+            policy_action_name((PolicyAction)raw_default.action), raw_default.max_frozen);
+
+    for (int i = 0; i < rule_count; i++) {
+        const RawRule* rule = &raw_rules[i];
+        fprintf(f, "app %s=\"%s\"", rule->match == MATCH_NAME ? "name" : "exe", rule->pattern);
+        write_pair(f, "timeout", rule->timeout);
+        write_pair(f, "min_memory", rule->min_memory);
+        if (rule->action >= 0) fprintf(f, " action=%s", policy_action_name((PolicyAction)rule->action));
+        write_pair(f, "max_frozen", rule->max_frozen);
+        fprintf(f, "\n");
+    }
+
+    fclose(f);
+    return true;
+}
+
+void policy_set_defaults(int timeout, int min_memory) {
+    if (timeout > 0) raw_default.timeout = timeout;
+    if (min_memory >= 0) raw_default.min_memory = min_memory;
+    policy_compile();
+}
+
+int policy_resolve(const char* name, const char* exe_path) {
+    if (!compiled) policy_compile();
+
+    // 1. Exact matches (hash lookups)
+    int best = lookup_exact(MATCH_NAME, name);
+    if (exe_path[0] != '\0') {
+        int by_exe = lookup_exact(MATCH_EXE, exe_path);
+        if (by_exe < best) best = by_exe;
+    }
+
+    // 2. Wildcards, only those written above the best exact match
+    for (int g = 0; g < glob_count && glob_rules[g] < best; g++) {
+        const PolicyRule* rule = &compiled_rules[glob_rules[g]];
+        const char* subject = (rule->match == MATCH_NAME) ? name : exe_path;
+        if (subject[0] != '\0' && glob_match(rule->pattern, subject)) {
+            best = glob_rules[g];
+            break;
+        }
+    }
+
+    return best == INT_MAX ? POLICY_DEFAULT : best;
+}
+
+const PolicyRule* policy_rule(int index) {
+    if (!compiled) policy_compile();
+    if (index < 0 || index >= rule_count) return &compiled_default;
+    return &compiled_rules[index];
+}
+
+int policy_rule_count(void) {
+    return rule_count;
+}
@@ -0,0 +1,90 @@
+#ifndef POLICY_H
+#define POLICY_H
+
+#include <stdbool.h>
+
+#define POLICY_FILENAME "macnap.policy"
+
+// Rule index meaning "no app rule matched, use the default line"
+#define POLICY_DEFAULT -1
+
+#define MAX_POLICY_RULES 64
+#define MAX_POLICY_PATTERN 512
+
+/**
+ * ----------------------------------------------------------------------
+ * THE POLICY ENGINE
+ * ----------------------------------------------------------------------
+ * macnap.policy is a list of per-app rules, one per line:
+ *
+ *   default timeout=10 min_memory=50 action=freeze
+ *   app name=Spotify action=never
+ *   app exe="/Applications/Slack.app/Contents/MacOS/Slack" timeout=60 min_memory=500 max_frozen=600
+ *   app name=zoom.us action=throttle
+ *
+ * The first matching "app" line wins. Anything a rule leaves out comes
+ * from the "default" line. Rules match the app's group leader (see
+ * group.h) and apply to all its helpers; a helper whose own rule says
+ * "never" is left out of the group instead. Exact names/paths are compiled into a hash
+ * table at load time, so resolving a PID is O(1) plus a short glob scan,
+ * and the result is cached in AppState.rule.
+ * ----------------------------------------------------------------------
+ */
+
+typedef enum {
+    POLICY_FREEZE = 0,   // Stop the process (SIGSTOP / SuspendThread)
+    POLICY_THROTTLE,     // Keep it running at background CPU/IO priority
+    POLICY_RECLAIM,      // Ask the OS to page its memory out
+    POLICY_NEVER         // Leave it alone (like the whitelist)
+} PolicyAction;
+
+typedef enum {
+    MATCH_NAME = 0,      // Short process name (os_get_process_name)
+    MATCH_EXE            // Full executable path (os_get_process_path)
+} PolicyMatch;
+
+typedef struct {
+    PolicyMatch match;
+    char pattern[MAX_POLICY_PATTERN];
+    int timeout;         // Seconds idle before acting
+    int min_memory;      // MB, smaller apps are ignored
+    PolicyAction action;
+    int max_frozen;      // Seconds before we force a thaw (0 = forever)
+} PolicyRule;
+
+/**
+ * @brief Loads and compiles a policy file.
+ * * Bad lines are reported and skipped, the rest still loads.
+ * @return bool false if the file does not exist (built-in defaults stay active).
+ */
+bool policy_load(const char* path);
+
+/**
+ * @brief Writes the current rules back to disk (used by --setup and first run).
+ */
+bool policy_save(const char* path);
+
+/**
+ * @brief Changes the default timeout / memory threshold and recompiles.
+ */
+void policy_set_defaults(int timeout, int min_memory);
+
+/**
+ * @brief Finds the rule for an app. Call once per app and cache the result.
+ * * @param name The short process name.
+ * @param exe_path The full executable path ("" if unknown).
+ * @return int Rule index, or POLICY_DEFAULT if no app rule matched.
+ */
+int policy_resolve(const char* name, const char* exe_path);
+
+/**
+ * @brief Returns the effective rule (defaults already filled in).
+ * * @param index A value from policy_resolve, or POLICY_DEFAULT.
+ */
+const PolicyRule* policy_rule(int index);
+
+int policy_rule_count(void);
+
+const char* policy_action_name(PolicyAction action);
+
+#endif // POLICY_H
@@ -0,0 +1,151 @@
+#include <string.h>
+#include "status.h"
+#include "policy.h"
+
+#ifdef _WIN32
+    #include <process.h>
+    #define current_pid() _getpid()
+#else
+    #include <unistd.h>
+    #define current_pid() getpid()
+#endif
+
+// "MNST" in ASCII
+#define STATUS_MAGIC   0x4D4E5354u
+// Bump this whenever StatusPage or StatusApp change layout
+#define STATUS_VERSION 1u
+
+// How often a reader retries before giving up on a busy page
+#define STATUS_READ_RETRIES 1000
+
+static StatusPage* page = NULL;
+
+// --- SEQLOCK (writer side) ---
+// Odd sequence = "don't trust what you read". The release fence makes
+// sure no data write can become visible before the odd number does.
+static void write_begin() {
+    uint32_t seq = atomic_load_explicit(&page->sequence, memory_order_relaxed);
+    atomic_store_explicit(&page->sequence, seq + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+}
+
+static void write_end() {
+    uint32_t seq = atomic_load_explicit(&page->sequence, memory_order_relaxed);
+    atomic_store_explicit(&page->sequence, seq + 1, memory_order_release);
+}
+
+bool status_open(bool dry_run) {
+    page = (StatusPage*)os_shm_create(STATUS_SHM_NAME, sizeof(StatusPage));
+    if (page == NULL) return false;
+
+    // A previous daemon may have died halfway through a write
+    uint32_t seq = atomic_load_explicit(&page->sequence, memory_order_relaxed);
+    if (seq & 1) atomic_store_explicit(&page->sequence, seq + 1, memory_order_relaxed);
+
+    write_begin();
+    page->magic = STATUS_MAGIC;
+    page->version = STATUS_VERSION;
+    page->state = STATUS_RUNNING;
+    page->daemon_pid = (int32_t)current_pid();
+    page->started_at = (int64_t)time(NULL);
+    page->updated_at = page->started_at;
+    page->dry_run = dry_run;
+    page->tick_count = 0;
+    page->tick_last_ns = 0;
+    page->tick_avg_ns = 0;
+    page->tick_max_ns = 0;
+    page->stats_frozen_count = 0;
+    page->stats_ram_saved_mb = 0;
+    page->app_count = 0;
+    write_end();
+
+    return true;
+}
+
+void status_publish(const AppState* apps, int count, uint64_t tick_ns,
+                    int frozen_count, uint64_t ram_saved_mb) {
+    if (page == NULL) return;
+
+    time_t now = time(NULL);
+
+    write_begin();
+
+    page->updated_at = (int64_t)now;
+    page->tick_count++;
+    page->tick_last_ns = tick_ns;
+    // Moving average over ~16 ticks
+    if (page->tick_avg_ns == 0) page->tick_avg_ns = tick_ns;
+    else page->tick_avg_ns = page->tick_avg_ns - page->tick_avg_ns / 16 + tick_ns / 16;
+    if (tick_ns > page->tick_max_ns) page->tick_max_ns = tick_ns;
+
+    page->stats_frozen_count = frozen_count;
+    page->stats_ram_saved_mb = ram_saved_mb;
+
+    int n = 0;
+    for (int i = 0; i < count; i++) {
+        if (!apps[i].valid) continue;
+
+        const AppState* app = &apps[i];
+        const PolicyRule* rule = policy_rule(app->rule);
+        StatusApp* out = &page->apps[n++];
+
+        out->pid = app->pid;
+        memcpy(out->name, app->name, MAX_PROC_NAME);
+        out->member_count = app->member_count;
+        out->memory_bytes = app->memory_bytes;
+        // A frozen app isn't sampled any more, the others still run
+        out->cpu_percent = (app->is_frozen && app->action == POLICY_FREEZE) ? 0.0 : app->cpu_percent;
+        out->idle_seconds = (int32_t)difftime(now, app->last_active_time);
+        out->frozen_seconds = app->is_frozen ? (int32_t)difftime(now, app->frozen_since) : 0;
+        out->is_frozen = app->is_frozen;
+        out->action = app->action;
+        out->policy_action = rule->action;
+        out->timeout = rule->timeout;
+        out->freeze_count = app->freeze_count;
+    }
+    page->app_count = n;
+
+    write_end();
+}
+
+void status_close(void) {
+    if (page == NULL) return;
+
+    write_begin();
+    page->state = STATUS_STOPPED;
+    page->updated_at = (int64_t)time(NULL);
+    write_end();
+
+    os_shm_close(page, sizeof(StatusPage));
+    page = NULL;
+}
+
+// --- READER SIDE ---
+
+const StatusPage* status_attach(void) {
+    return (const StatusPage*)os_shm_open_readonly(STATUS_SHM_NAME, sizeof(StatusPage));
+}
+
+bool status_read(const StatusPage* shared, StatusPage* out) {
+    StatusPage* source = (StatusPage*)shared; // atomics need a non-const pointer
+
+    for (int attempt = 0; attempt < STATUS_READ_RETRIES; attempt++) {
+        uint32_t before = atomic_load_explicit(&source->sequence, memory_order_acquire);
+        if (before & 1) continue; // Writer is busy
+
+        memcpy(out, shared, sizeof(StatusPage));
+
+        // Our copy must be finished before we look at the sequence again
+        atomic_thread_fence(memory_order_acquire);
+        uint32_t after = atomic_load_explicit(&source->sequence, memory_order_relaxed);
+
+        if (before == after) {
+            return out->magic == STATUS_MAGIC && out->version == STATUS_VERSION;
+        }
+    }
+    return false;
+}
+
+void status_detach(const StatusPage* shared) {
+    os_shm_close(shared, sizeof(StatusPage));
+}
@@ -0,0 +1,104 @@
+#ifndef STATUS_H
+#define STATUS_H
+
+#include <stdatomic.h>
+#include "app_state.h"
+
+// Shared-memory segment name (see os_shm_create)
+#define STATUS_SHM_NAME "macnap.status"
+
+/**
+ * ----------------------------------------------------------------------
+ * THE STATUS PAGE
+ * ----------------------------------------------------------------------
+ * The daemon copies its app table and loop timings into a shared-memory
+ * segment once per tick. Readers (macnap_top) map it read-only.
+ *
+ * It is guarded by a seqlock: the writer bumps 'sequence' to an odd
+ * number, writes, then bumps it to even again. A reader copies the page
+ * and retries if the sequence was odd or changed underneath it.
+ * The writer never waits for anyone, so a slow or stuck viewer can't
+ * slow down the control loop.
+ * ----------------------------------------------------------------------
+ */
+
+typedef enum {
+    STATUS_STOPPED = 0,
+    STATUS_RUNNING
+} StatusState;
+
+typedef struct {
+    int32_t pid;                // Group leader
+    char name[MAX_PROC_NAME];
+    int32_t member_count;
+    uint64_t memory_bytes;      // Whole group
+    double cpu_percent;         // Whole group
+    int32_t idle_seconds;
+    int32_t frozen_seconds;     // 0 if not frozen
+    int32_t is_frozen;
+    int32_t action;             // PolicyAction applied (while frozen)
+    int32_t policy_action;      // PolicyAction the rule asks for
+    int32_t timeout;            // From the rule
+    int32_t freeze_count;       // Score
+} StatusApp;
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    _Atomic uint32_t sequence;  // Odd = write in progress
+
+    int32_t state;              // StatusState
+    int32_t daemon_pid;
+    int64_t started_at;         // time_t
+    int64_t updated_at;         // time_t of the last publish
+    int32_t dry_run;
+
+    // Loop timings (work per tick, without the 1s sleep)
+    uint64_t tick_count;
+    uint64_t tick_last_ns;
+    uint64_t tick_avg_ns;       // Moving average
+    uint64_t tick_max_ns;
+
+    // Session statistics
+    int32_t stats_frozen_count;
+    uint64_t stats_ram_saved_mb;
+
+    int32_t app_count;
+    StatusApp apps[MAX_TRACKED_APPS];
+} StatusPage;
+
+// --- WRITER (the daemon) ---
+
+/**
+ * @brief Creates the segment and marks it RUNNING. Returns false if unavailable.
+ */
+bool status_open(bool dry_run);
+
+/**
+ * @brief Copies one tick's worth of state into the page. Never blocks.
+ * * Does nothing if status_open failed.
+ */
+void status_publish(const AppState* apps, int count, uint64_t tick_ns,
+                    int frozen_count, uint64_t ram_saved_mb);
+
+/**
+ * @brief Marks the page STOPPED and unmaps it.
+ */
+void status_close(void);
+
+// --- READER (macnap_top) ---
+
+/**
+ * @brief Maps the page read-only. Returns NULL if no daemon created it yet.
+ */
+const StatusPage* status_attach(void);
+
+/**
+ * @brief Takes a consistent copy of the page (seqlock read).
+ * @return bool false if the page is invalid or stayed busy for too long.
+ */
+bool status_read(const StatusPage* page, StatusPage* out);
+
+void status_detach(const StatusPage* page);
+
+#endif // STATUS_H
@@ -0,0 +1,549 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include "os_interface.h"
+#include "group.h"
+
+/**
+ * ----------------------------------------------------------------------
+ * MACNAP BENCH
+ * ----------------------------------------------------------------------
+ * Measures what the platform primitives cost. MacNap calls them every
+ * second, forever, so a few microseconds here matter.
+ *
+ * We spawn native worker children (like victim.py, but multi-process and
+ * multi-threaded), then time:
+ *   1. Every os_* call on its own (latency distribution)
+ *   2. Freeze -> stopped and Thaw -> running round trips
+ *   3. App grouping: process table scan, group refresh and group sample
+ *      (the workers are our children, so they form our own app group)
+ *   4. One full main-loop tick at 10 / 100 / 1000 tracked processes
+ *
+ * Use --json for one JSON object per line (for regression tracking).
+ * ----------------------------------------------------------------------
+ */
+
+// --- DEFAULTS ---
+#define DEFAULT_WORKERS   8
+#define DEFAULT_THREADS   4
+#define DEFAULT_MEM_MB    16
+#define DEFAULT_ITERS     1000
+#define MAX_WORKERS       1024
+#define MAX_TICK_SIZES    8
+#define ROUND_TRIP_TIMEOUT_US 1000000.0   // Give up waiting for a state change after 1s
+
+// --- CROSS-PLATFORM SLEEP & CHILDREN ---
+#ifdef _WIN32
+    #include <windows.h>
+    #include <process.h>
+    #define PLATFORM_NAME "windows"
+    #define getpid _getpid
+
+    void sleep_ms(int ms) { Sleep(ms); }
+
+    PROCESS_INFORMATION children[MAX_WORKERS];
+#else
+    #include <unistd.h>
+    #include <pthread.h>
+    #include <sys/wait.h>
+    #define PLATFORM_NAME "macos"
+
+    void sleep_ms(int ms) { usleep(ms * 1000); }
+#endif
+
+double now_us(void) {
+    return (double)os_get_time_ns() / 1e3;
+}
+
+// Runtime Configuration
+int config_workers = DEFAULT_WORKERS;
+int config_threads = DEFAULT_THREADS;
+int config_mem_mb  = DEFAULT_MEM_MB;
+int config_iters   = DEFAULT_ITERS;
+int config_tick_sizes[MAX_TICK_SIZES] = {10, 100, 1000};
+int config_tick_count = 3;
+bool flag_json = false;
+
+int32_t worker_pids[MAX_WORKERS];
+int worker_count = 0;
+
+ProcessEntry process_table[MAX_PROCESSES];
+
+// ======================================================================
+// WORKER CHILD
+// ======================================================================
+
+// Shared by all threads of one worker
+unsigned char* worker_memory = NULL;
+size_t worker_memory_size = 0;
+
+// One worker thread: keep touching our pages and yield, like a quiet background app
+#ifdef _WIN32
+DWORD WINAPI worker_thread(LPVOID arg) {
+#else
+void* worker_thread(void* arg) {
+#endif
+    size_t offset = (size_t)(uintptr_t)arg * 4096;
+    while (1) {
+        if (worker_memory_size > 0) {
+            worker_memory[offset % worker_memory_size]++;
+            offset += 4096;
+        }
+        sleep_ms(10);
+    }
+    return 0;
+}
+
+void run_worker(int threads, int mem_mb) {
+    worker_memory_size = (size_t)mem_mb * 1024 * 1024;
+    if (worker_memory_size > 0) {
+        worker_memory = malloc(worker_memory_size);
+        if (worker_memory == NULL) exit(EXIT_FAILURE);
+        // Touch everything so it shows up as resident memory
+        memset(worker_memory, 1, worker_memory_size);
+    }
+
+    // Main thread counts as thread #0
+    for (int t = 1; t < threads; t++) {
+        #ifdef _WIN32
+            CreateThread(NULL, 0, worker_thread, (LPVOID)(uintptr_t)t, 0, NULL);
+        #else
+            pthread_t tid;
+            pthread_create(&tid, NULL, worker_thread, (void*)(uintptr_t)t);
+        #endif
+    }
+    worker_thread(NULL);
+    exit(EXIT_SUCCESS);
+}
+
+// ======================================================================
+// SPAWN & CLEANUP
+// ======================================================================
+
+int32_t spawn_worker(int index) {
+    #ifdef _WIN32
+        // No fork() on Windows: start ourselves again in worker mode
+        char exe[MAX_PATH];
+        char cmd[MAX_PATH + 64];
+        GetModuleFileNameA(NULL, exe, sizeof(exe));
+        snprintf(cmd, sizeof(cmd), "\"%s\" --worker %d %d", exe, config_threads, config_mem_mb);
+
+        STARTUPINFOA si;
+        memset(&si, 0, sizeof(si));
+        si.cb = sizeof(si);
+
+        if (!CreateProcessA(NULL, cmd, NULL, NULL, FALSE, 0, NULL, NULL, &si, &children[index])) {
+            return -1;
+        }
+        return (int32_t)children[index].dwProcessId;
+    #else
+        (void)index;
+        pid_t pid = fork();
+        if (pid < 0) return -1;
+        if (pid == 0) run_worker(config_threads, config_mem_mb); // never returns
+        return (int32_t)pid;
+    #endif
+}
+
+void kill_workers() {
+    for (int i = 0; i < worker_count; i++) {
+        #ifdef _WIN32
+            TerminateProcess(children[i].hProcess, 0);
+            CloseHandle(children[i].hThread);
+            CloseHandle(children[i].hProcess);
+        #else
+            // SIGKILL works on stopped processes too, no thaw needed
+            kill(worker_pids[i], SIGKILL);
+            waitpid(worker_pids[i], NULL, 0);
+        #endif
+    }
+    worker_count = 0;
+}
+
+void handle_exit(int sig) {
+    (void)sig;
+    // Never leave frozen children behind
+    kill_workers();
+    exit(1);
+}
+
+// ======================================================================
+// STATISTICS
+// ======================================================================
+
+typedef struct {
+    double* samples;   // microseconds
+    int count;
+    int capacity;
+    int failures;      // calls that errored / timed out
+} Samples;
+
+void samples_init(Samples* s, int capacity) {
+    s->samples = malloc(sizeof(double) * (size_t)capacity);
+    s->count = 0;
+    s->capacity = capacity;
+    s->failures = 0;
+    if (s->samples == NULL) {
+        fprintf(stderr, "[ERROR] Out of memory for %d samples\n", capacity);
+        handle_exit(0);
+    }
+}
+
+void samples_add(Samples* s, double us) {
+    if (s->count < s->capacity) s->samples[s->count++] = us;
+}
+
+int compare_doubles(const void* a, const void* b) {
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+double percentile(const Samples* s, double p) {
+    if (s->count == 0) return 0.0;
+    int index = (int)(p * (s->count - 1) + 0.5);
+    return s->samples[index];
+}
+
+void print_header() {
+    if (flag_json) return;
+    printf("%-26s %8s %10s %10s %10s %10s %10s %10s %6s\n",
+           "benchmark (us)", "n", "min", "p50", "p90", "p99", "max", "mean", "fail");
+    printf("---------------------------------------------------------------------------------------------------\n");
+}
+
+// Sorts in place, prints one row (text) or one line (JSON), then frees
+void report(const char* name, int tracked, Samples* s) {
+    qsort(s->samples, (size_t)s->count, sizeof(double), compare_doubles);
+
+    double sum = 0.0;
+    for (int i = 0; i < s->count; i++) sum += s->samples[i];
+    double mean = s->count ? sum / s->count : 0.0;
+
+    if (flag_json) {
+        printf("{\"benchmark\":\"%s\",\"platform\":\"%s\",\"workers\":%d,\"threads\":%d,"
+               "\"mem_mb\":%d,\"tracked\":%d,\"unit\":\"us\",\"n\":%d,\"failures\":%d,"
+               "\"min\":%.3f,\"p50\":%.3f,\"p90\":%.3f,\"p99\":%.3f,\"max\":%.3f,\"mean\":%.3f}\n",
+               name, PLATFORM_NAME, worker_count, config_threads, config_mem_mb, tracked,
+               s->count, s->failures,
+               percentile(s, 0.0), percentile(s, 0.5), percentile(s, 0.9),
+               percentile(s, 0.99), percentile(s, 1.0), mean);
+    }
+    else {
+        char label[64];
+        if (tracked > 0) snprintf(label, sizeof(label), "%s[%d]", name, tracked);
+        else             snprintf(label, sizeof(label), "%s", name);
+
+        printf("%-26s %8d %10.2f %10.2f %10.2f %10.2f %10.2f %10.2f %6d\n",
+               label, s->count,
+               percentile(s, 0.0), percentile(s, 0.5), percentile(s, 0.9),
+               percentile(s, 0.99), percentile(s, 1.0), mean, s->failures);
+    }
+    fflush(stdout);
+
+    free(s->samples);
+    s->samples = NULL;
+}
+
+// ======================================================================
+// BENCHMARKS
+// ======================================================================
+
+void bench_single_calls() {
+    Samples active, name, memory, cpu, freeze, thaw;
+    samples_init(&active, config_iters);
+    samples_init(&name, config_iters);
+    samples_init(&memory, config_iters);
+    samples_init(&cpu, config_iters);
+    samples_init(&freeze, config_iters);
+    samples_init(&thaw, config_iters);
+
+    char buffer[MAX_PROC_NAME];
+
+    for (int i = 0; i < config_iters; i++) {
+        int32_t pid = worker_pids[i % worker_count];
+        double t0, t1;
+
+        t0 = now_us();
+        int32_t active_pid = os_get_active_pid();
+        t1 = now_us();
+        samples_add(&active, t1 - t0);
+        if (active_pid < 0) active.failures++;
+
+        t0 = now_us();
+        os_get_process_name(pid, buffer, sizeof(buffer));
+        t1 = now_us();
+        samples_add(&name, t1 - t0);
+        if (strcmp(buffer, "Unknown") == 0) name.failures++;
+
+        t0 = now_us();
+        uint64_t bytes = os_get_memory_usage(pid);
+        t1 = now_us();
+        samples_add(&memory, t1 - t0);
+        if (bytes == 0) memory.failures++;
+
+        t0 = now_us();
+        uint64_t ns = os_get_cpu_time(pid);
+        t1 = now_us();
+        samples_add(&cpu, t1 - t0);
+        if (ns == 0) cpu.failures++;
+
+        t0 = now_us();
+        int ret = os_freeze_process(pid);
+        t1 = now_us();
+        samples_add(&freeze, t1 - t0);
+        if (ret != 0) freeze.failures++;
+
+        t0 = now_us();
+        ret = os_thaw_process(pid);
+        t1 = now_us();
+        samples_add(&thaw, t1 - t0);
+        if (ret != 0) thaw.failures++;
+    }
+
+    report("os_get_active_pid", 0, &active);
+    report("os_get_process_name", 0, &name);
+    report("os_get_memory_usage", 0, &memory);
+    report("os_get_cpu_time", 0, &cpu);
+    report("os_freeze_process", 0, &freeze);
+    report("os_thaw_process", 0, &thaw);
+}
+
+// Spin until the process reaches the wanted state. Returns elapsed us, or -1 on timeout.
+double wait_for_state(int32_t pid, bool want_frozen, double t0) {
+    while (os_is_process_frozen(pid) != want_frozen) {
+        if (now_us() - t0 > ROUND_TRIP_TIMEOUT_US) return -1.0;
+    }
+    return now_us() - t0;
+}
+
+void bench_round_trips() {
+    Samples to_stopped, to_running;
+    samples_init(&to_stopped, config_iters);
+    samples_init(&to_running, config_iters);
+
+    for (int i = 0; i < config_iters; i++) {
+        int32_t pid = worker_pids[i % worker_count];
+
+        double t0 = now_us();
+        os_freeze_process(pid);
+        double elapsed = wait_for_state(pid, true, t0);
+        if (elapsed < 0) to_stopped.failures++;
+        else             samples_add(&to_stopped, elapsed);
+
+        t0 = now_us();
+        os_thaw_process(pid);
+        elapsed = wait_for_state(pid, false, t0);
+        if (elapsed < 0) to_running.failures++;
+        else             samples_add(&to_running, elapsed);
+    }
+
+    report("freeze_to_stopped", 0, &to_stopped);
+    report("thaw_to_running", 0, &to_running);
+}
+
+// Our own app group: we are the leader, the workers are our helpers
+void init_bench_group(AppState* app) {
+    memset(app, 0, sizeof(AppState));
+    app->pid = (int32_t)getpid();
+    app->start_time = os_get_process_start_time(app->pid);
+    os_get_process_name(app->pid, app->name, MAX_PROC_NAME);
+}
+
+// What MacNap pays to keep app groups up to date
+void bench_groups() {
+    int iters = config_iters / 10;
+    if (iters < 10) iters = 10;
+
+    Samples table, refresh, sample;
+    samples_init(&table, iters);
+    samples_init(&refresh, iters);
+    samples_init(&sample, iters);
+
+    AppState app;
+    init_bench_group(&app);
+
+    // Leader + every worker, as far as a group can hold them
+    int expected = worker_count + 1;
+    if (expected > MAX_GROUP_MEMBERS) expected = MAX_GROUP_MEMBERS;
+
+    for (int i = 0; i < iters; i++) {
+        double t0 = now_us();
+        int count = os_list_processes(process_table, MAX_PROCESSES);
+        samples_add(&table, now_us() - t0);
+        if (count <= 0) table.failures++;
+
+        // Includes its own process table scan, like the first refresh of a tick
+        group_invalidate_snapshot();
+        t0 = now_us();
+        group_refresh(&app, NULL);
+        samples_add(&refresh, now_us() - t0);
+        if (app.member_count < expected) refresh.failures++;
+
+        t0 = now_us();
+        group_sample(&app, time(NULL));
+        samples_add(&sample, now_us() - t0);
+    }
+
+    report("os_list_processes", 0, &table);
+    report("group_refresh", app.member_count, &refresh);
+    report("group_sample", app.member_count, &sample);
+}
+
+// One tick of MacNap's main loop: who is active and which app owns it
+// (a fresh process table), one due group refresh, and memory + CPU of
+// every tracked process (group_sample in check_for_idlers).
+void bench_ticks(int tracked) {
+    int ticks = config_iters / 10;
+    if (ticks < 10) ticks = 10;
+
+    Samples tick;
+    samples_init(&tick, ticks);
+
+    AppState refreshed;
+    init_bench_group(&refreshed);
+
+    // Tracked processes are packed into full groups that cycle over the real
+    // workers, so 1000 members don't need 1000 children
+    int group_count = (tracked + MAX_GROUP_MEMBERS - 1) / MAX_GROUP_MEMBERS;
+    AppState* groups = calloc((size_t)group_count, sizeof(AppState));
+    if (groups == NULL) handle_exit(0);
+    for (int i = 0; i < tracked; i++) {
+        AppState* app = &groups[i / MAX_GROUP_MEMBERS];
+        app->members[app->member_count].pid = worker_pids[i % worker_count];
+        app->member_count++;
+    }
+
+    char buffer[MAX_PROC_NAME];
+    volatile int32_t sink = 0; // keep the compiler from dropping the calls
+
+    for (int t = 0; t < ticks; t++) {
+        time_t now = time(NULL);
+        group_invalidate_snapshot(); // MacNap ticks once per second, the snapshot is always stale
+        double t0 = now_us();
+
+        int32_t active_pid = os_get_active_pid();
+        if (active_pid > 0) {
+            os_get_process_name(active_pid, buffer, sizeof(buffer));
+            sink += group_find_leader(active_pid);
+        }
+
+        group_refresh(&refreshed, NULL);
+
+        for (int g = 0; g < group_count; g++) {
+            group_sample(&groups[g], now);
+        }
+
+        samples_add(&tick, now_us() - t0);
+    }
+    (void)sink;
+
+    free(groups);
+    report("loop_tick", tracked, &tick);
+}
+
+// ======================================================================
+// MAIN
+// ======================================================================
+
+void print_usage() {
+    printf("\nmacnap_bench Usage:\n");
+    printf("  ./macnap_bench                 Run all benchmarks with defaults\n");
+    printf("  ./macnap_bench --workers N     Worker processes to spawn [Default: %d]\n", DEFAULT_WORKERS);
+    printf("  ./macnap_bench --threads N     Threads per worker [Default: %d]\n", DEFAULT_THREADS);
+    printf("  ./macnap_bench --mem MB        Resident memory per worker [Default: %d]\n", DEFAULT_MEM_MB);
+    printf("  ./macnap_bench --iters N       Samples per call benchmark [Default: %d]\n", DEFAULT_ITERS);
+    printf("  ./macnap_bench --tracked LIST  Loop tick sizes, e.g. 10,100,1000\n");
+    printf("  ./macnap_bench --json          One JSON object per line\n");
+    printf("  ./macnap_bench --help          Show this message\n\n");
+}
+
+// "10,100,1000" -> config_tick_sizes
+bool parse_tick_sizes(const char* list) {
+    int count = 0;
+    const char* p = list;
+    while (*p && count < MAX_TICK_SIZES) {
+        char* end;
+        long value = strtol(p, &end, 10);
+        if (end == p || value <= 0) return false;
+        config_tick_sizes[count++] = (int)value;
+        p = (*end == ',') ? end + 1 : end;
+    }
+    config_tick_count = count;
+    return count > 0;
+}
+
+int parse_positive(const char* text) {
+    int value = atoi(text);
+    return value > 0 ? value : -1;
+}
+
+int main(int argc, char* argv[]) {
+    // Hidden mode: we are one of our own worker children (Windows re-exec)
+    if (argc == 4 && strcmp(argv[1], "--worker") == 0) {
+        run_worker(atoi(argv[2]), atoi(argv[3]));
+    }
+
+    for (int i = 1; i < argc; i++) {
+        bool has_value = (i + 1 < argc);
+
+        if (strcmp(argv[i], "--help") == 0) {
+            print_usage();
+            return 0;
+        }
+        else if (strcmp(argv[i], "--json") == 0) flag_json = true;
+        else if (strcmp(argv[i], "--workers") == 0 && has_value) config_workers = parse_positive(argv[++i]);
+        else if (strcmp(argv[i], "--threads") == 0 && has_value) config_threads = parse_positive(argv[++i]);
+        else if (strcmp(argv[i], "--iters") == 0 && has_value)   config_iters = parse_positive(argv[++i]);
+        else if (strcmp(argv[i], "--mem") == 0 && has_value)     config_mem_mb = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--tracked") == 0 && has_value) {
+            if (!parse_tick_sizes(argv[++i])) config_tick_count = -1;
+        }
+        else {
+            fprintf(stderr, "[ERROR] Unknown option '%s'\n", argv[i]);
+            print_usage();
+            return 1;
+        }
+    }
+
+    if (config_workers <= 0 || config_workers > MAX_WORKERS || config_threads <= 0 ||
+        config_iters <= 0 || config_mem_mb < 0 || config_tick_count <= 0) {
+        fprintf(stderr, "[ERROR] Invalid option value (workers 1-%d, threads/iters > 0, mem >= 0)\n", MAX_WORKERS);
+        return 1;
+    }
+
+    signal(SIGINT, handle_exit);
+    signal(SIGTERM, handle_exit);
+
+    // 1. SPAWN WORKERS
+    for (int i = 0; i < config_workers; i++) {
+        int32_t pid = spawn_worker(i);
+        if (pid < 0) {
+            fprintf(stderr, "[ERROR] Could not spawn worker #%d\n", i);
+            kill_workers();
+            return 1;
+        }
+        worker_pids[worker_count++] = pid;
+    }
+
+    // Let them allocate and touch their memory before we measure anything
+    sleep_ms(200 + config_mem_mb * 5);
+
+    if (!flag_json) {
+        printf("\nmacnap_bench: %s | %d workers x %d threads | %d MB each | %d iterations\n\n",
+               PLATFORM_NAME, worker_count, config_threads, config_mem_mb, config_iters);
+    }
+    print_header();
+
+    // 2. RUN
+    bench_single_calls();
+    bench_round_trips();
+    bench_groups();
+    for (int i = 0; i < config_tick_count; i++) bench_ticks(config_tick_sizes[i]);
+
+    // 3. CLEANUP
+    kill_workers();
+    if (!flag_json) printf("\n");
+    return 0;
+}
@@ -0,0 +1,192 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "os_interface.h"
+#include "policy.h"
+#include "status.h"
+
+/**
+ * ----------------------------------------------------------------------
+ * MACNAP TOP
+ * ----------------------------------------------------------------------
+ * Live view of a running MacNap (also in --daemon mode).
+ * Reads the shared-memory status page, never talks to the daemon,
+ * so it costs the daemon nothing.
+ * ----------------------------------------------------------------------
+ */
+
+#define DEFAULT_INTERVAL_MS 1000
+#define STALE_AFTER_SECONDS 5    // Daemon publishes every ~1s
+
+// --- ANSI COLORS (same palette as MacNap) ---
+#define COLOR_RESET   "\033[0m"
+#define COLOR_RED     "\033[31m"    // Frozen
+#define COLOR_GREEN   "\033[32m"    // Running / Active
+#define COLOR_YELLOW  "\033[33m"    // Throttled / Warnings
+#define COLOR_CYAN    "\033[36m"    // Reclaimed / Info
+#define COLOR_BOLD    "\033[1m"     // Headers
+#define CLEAR_SCREEN  "\033[H\033[2J"
+
+// --- CROSS-PLATFORM SLEEP ---
+#ifdef _WIN32
+    #include <windows.h>
+    void sleep_ms(int ms) { Sleep(ms); }
+#else
+    #include <unistd.h>
+    void sleep_ms(int ms) { usleep(ms * 1000); }
+#endif
+
+// Biggest apps first
+int compare_memory(const void* a, const void* b) {
+    const StatusApp* x = (const StatusApp*)a;
+    const StatusApp* y = (const StatusApp*)b;
+    return (y->memory_bytes > x->memory_bytes) - (y->memory_bytes < x->memory_bytes);
+}
+
+// 3725 -> "1h02m", 75 -> "1m15s", 9 -> "9s"
+void format_duration(int64_t seconds, char* buffer, size_t size) {
+    if (seconds < 0) seconds = 0;
+    if (seconds >= 3600)    snprintf(buffer, size, "%lldh%02lldm", (long long)(seconds / 3600), (long long)(seconds % 3600 / 60));
+    else if (seconds >= 60) snprintf(buffer, size, "%lldm%02llds", (long long)(seconds / 60), (long long)(seconds % 60));
+    else                    snprintf(buffer, size, "%llds", (long long)seconds);
+}
+
+const char* state_label(const StatusApp* app, const char** color) {
+    if (!app->is_frozen) {
+        *color = (app->idle_seconds <= 1) ? COLOR_GREEN : COLOR_RESET;
+        return (app->idle_seconds <= 1) ? "ACTIVE" : "RUNNING";
+    }
+    switch (app->action) {
+        case POLICY_THROTTLE: *color = COLOR_YELLOW; return "THROTTLED";
+        case POLICY_RECLAIM:  *color = COLOR_CYAN;   return "RECLAIMED";
+        default:              *color = COLOR_RED;    return "FROZEN";
+    }
+}
+
+void render(const StatusPage* page, bool clear) {
+    time_t now = time(NULL);
+    char uptime[32];
+    format_duration(now - page->started_at, uptime, sizeof(uptime));
+
+    if (clear) printf(CLEAR_SCREEN);
+
+    // 1. HEADER
+    int64_t silence = now - page->updated_at;
+    printf(COLOR_BOLD "MacNap top" COLOR_RESET " | daemon PID %d | ", page->daemon_pid);
+    if (page->state != STATUS_RUNNING)        printf(COLOR_RED "STOPPED" COLOR_RESET);
+    else if (silence > STALE_AFTER_SECONDS)   printf(COLOR_YELLOW "STALE (no update for %llds)" COLOR_RESET, (long long)silence);
+    else                                      printf(COLOR_GREEN "RUNNING" COLOR_RESET);
+    printf(" | up %s", uptime);
+    if (page->dry_run) printf(COLOR_YELLOW " | DRY RUN" COLOR_RESET);
+    printf("\n");
+
+    printf(COLOR_CYAN "Loop:    last %.2f ms | avg %.2f ms | max %.2f ms | %llu ticks" COLOR_RESET "\n",
+           page->tick_last_ns / 1e6, page->tick_avg_ns / 1e6, page->tick_max_ns / 1e6,
+           (unsigned long long)page->tick_count);
+    printf(COLOR_CYAN "Session: %d freezes | %llu MB reclaimed" COLOR_RESET "\n\n",
+           page->stats_frozen_count, (unsigned long long)page->stats_ram_saved_mb);
+
+    // 2. APP TABLE
+    StatusApp apps[MAX_TRACKED_APPS];
+    int count = page->app_count;
+    if (count < 0) count = 0;
+    if (count > MAX_TRACKED_APPS) count = MAX_TRACKED_APPS;
+    memcpy(apps, page->apps, sizeof(StatusApp) * (size_t)count);
+    qsort(apps, (size_t)count, sizeof(StatusApp), compare_memory);
+
+    printf(COLOR_BOLD "%7s  %-24s %5s %9s %6s  %-9s %7s %7s  %-8s %5s" COLOR_RESET "\n",
+           "PID", "APP", "PROCS", "RSS MB", "CPU%", "STATE", "IDLE", "FROZEN", "POLICY", "SCORE");
+
+    for (int i = 0; i < count; i++) {
+        const StatusApp* app = &apps[i];
+        const char* color;
+        const char* state = state_label(app, &color);
+
+        char idle[16], frozen[16];
+        format_duration(app->idle_seconds, idle, sizeof(idle));
+        if (app->is_frozen) format_duration(app->frozen_seconds, frozen, sizeof(frozen));
+        else                snprintf(frozen, sizeof(frozen), "-");
+
+        printf("%7d  %-24.24s %5d %9.0f %6.1f  %s%-9s%s %7s %7s  %-8s %5d\n",
+               app->pid, app->name, app->member_count,
+               (double)app->memory_bytes / (1024 * 1024), app->cpu_percent,
+               color, state, COLOR_RESET, idle, frozen,
+               policy_action_name((PolicyAction)app->policy_action), app->freeze_count);
+    }
+    if (count == 0) printf("   (no apps tracked yet)\n");
+
+    fflush(stdout);
+}
+
+// The page exists but no read succeeds: the daemon was killed halfway
+// through a publish (sequence stuck on odd), or it is another version
+void render_unreadable(int64_t seconds_failing) {
+    printf(CLEAR_SCREEN COLOR_BOLD "MacNap top" COLOR_RESET " | ");
+    printf(COLOR_RED "STATUS PAGE UNREADABLE" COLOR_RESET " for %llds\n\n", (long long)seconds_failing);
+    printf(COLOR_YELLOW "  The daemon died in the middle of an update, or it is a different MacNap version.\n");
+    printf("  The view comes back as soon as a MacNap (re)starts and publishes again." COLOR_RESET "\n");
+    fflush(stdout);
+}
+
+int main(int argc, char* argv[]) {
+    bool once = false;
+    int interval_ms = DEFAULT_INTERVAL_MS;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--help") == 0) {
+            printf("\nmacnap_top Usage:\n");
+            printf("  ./macnap_top                 Live view, refreshes every second\n");
+            printf("  ./macnap_top --interval MS   Refresh period in milliseconds\n");
+            printf("  ./macnap_top --once          Print one snapshot and exit\n");
+            printf("  ./macnap_top --help          Show this message\n\n");
+            return 0;
+        }
+        else if (strcmp(argv[i], "--once") == 0) once = true;
+        else if (strcmp(argv[i], "--interval") == 0 && i + 1 < argc) {
+            interval_ms = atoi(argv[++i]);
+            if (interval_ms < 50) interval_ms = 50;
+        }
+        else {
+            fprintf(stderr, "[ERROR] Unknown option '%s' (try --help)\n", argv[i]);
+            return 1;
+        }
+    }
+
+    const StatusPage* page = status_attach();
+    if (page == NULL && once) {
+        fprintf(stderr, "[ERROR] No status page found. Is MacNap running?\n");
+        return 1;
+    }
+
+    StatusPage snapshot;
+    time_t last_read = time(NULL);
+    while (1) {
+        // The daemon may start after us
+        if (page == NULL) page = status_attach();
+
+        if (page == NULL) {
+            printf(CLEAR_SCREEN COLOR_YELLOW "Waiting for MacNap to start..." COLOR_RESET "\n");
+            fflush(stdout);
+        }
+        else if (status_read(page, &snapshot)) {
+            render(&snapshot, !once);
+            last_read = time(NULL);
+        }
+        else if (once) {
+            fprintf(stderr, "[ERROR] Status page is busy or from another MacNap version.\n");
+            status_detach(page);
+            return 1;
+        }
+        else {
+            // Never leave the last good frame up, it would still say RUNNING
+            render_unreadable(time(NULL) - last_read);
+        }
+
+        if (once) break;
+        sleep_ms(interval_ms);
+    }
+
+    status_detach(page);
+    return 0;
+}